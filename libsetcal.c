@@ -0,0 +1,5697 @@
+// File: libsetcal.c
+// Subject: IZP
+// Project: #2
+// Author: Andrii Klymenko, FIT VUT
+// Login: xklyme00
+// Date: 28.7.2023
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <stdarg.h>
+
+#include "setcal.h"
+
+#define MAX_LINE_NUMBER 1000
+
+#define MAX_LINE_LENGTH MAX_LINE_NUMBER
+#define LINE_BUFFER_SIZE MAX_LINE_LENGTH + 2 // + '\n' + '\0'
+
+#define MAX_SET_ELEMENT_LENGTH 30
+
+#define READ_BUFFER_SIZE 65536 // the file is read ahead in blocks of this size
+#define ERROR_BUFFER_SIZE 1024 // errors of one line are kept in a buffer of this size
+
+#define DELIMITER_STR " " // for strspn() and strcspn() functions
+#define DELIMITER_CHAR ' '
+
+// lines "S#" and "R#" give set elements by their positions in the line "U" (from 0) instead of their names
+#define POSITION_FORMAT_CHAR '#'
+#define MAX_POSITION_LENGTH 9 // a position has at most 9 digits (it fits into int)
+
+#define MAX_OPERATOR_LENGTH 13 // strlen("closure_trans") == 13
+#define OPERATOR_BUFFER_SIZE MAX_OPERATOR_LENGTH + 1 // + '\0'
+
+#define MAX_OPERANDS_NUMBER 4 // command can have maximum 4 operands (for example: "injective  id1 id2 id3 go_to_line)"
+
+// "union", "intersect" and "minus" can have any number of operands (every operand takes at least 2 characters)
+#define MAX_NARY_OPERANDS_NUMBER (MAX_LINE_LENGTH / 2)
+
+// maximum number of nodes of a nested set expression (every node takes at least 2 characters)
+#define MAX_EXPRESSION_NODES (MAX_LINE_LENGTH / 2)
+
+#define WORD_BITS 64 // number of bits in one word of a bitset
+#define AUTO_REFERENCE_PAIRS 8 // the "auto" engine uses the reference engine for operands with at most this number of pairs/elements
+#define WORD_BYTES 8 // number of characters of a line scanned at once
+#define LOW_BITS 0x7f7f7f7f7f7f7f7fULL // all bits but the highest one of every byte of a word
+#define BYTE_ONES 0x0101010101010101ULL // 1 in every byte of a word
+
+// if one sorted array of ids is at least GALLOP_RATIO times smaller than the other one
+// the bigger array is searched by galloping instead of being merged element by element
+#define GALLOP_RATIO 32
+
+// "sample" at the root of a nested set expression (the index after all commands in set_commands)
+#define EXPRESSION_SAMPLE 9
+
+#define ARRAY_SIZE(arr) ((int) (sizeof(arr) / sizeof((arr)[0]))) // number of items in the (static) array
+
+// commands over sets
+static const char *set_commands[] = {
+        "empty",
+        "card",
+        "complement",
+        "union",
+        "intersect",
+        "minus",
+        "subseteq",
+        "subset",
+        "equals"
+};
+
+// commands over relations + "select" which works with both sets and relations
+// new commands ("compose", "inverse", ...) are placed after "select" because commands are referred to by their index
+static const char *relation_commands[] = {
+        "reflexive",
+        "symmetric",
+        "antisymmetric",
+        "transitive",
+        "function",
+        "domain",
+        "codomain",
+        "injective",
+        "surjective",
+        "bijective",
+        "closure_ref",
+        "closure_sym",
+        "closure_trans",
+        "select",
+        "compose",
+        "inverse",
+        "closure_eq",
+        "classes",
+        "image",
+        "preimage",
+        "reach",
+        "sample"
+};
+
+// outputs of some commands over sets/relations
+static const char *key_words[] = {
+        "false",
+        "true"
+};
+
+// state of the xoshiro256** pseudo-random number generator used by "select" and "sample"
+static uint64_t random_state[4];
+
+// kinds of tracked blocks of memory, statistics are kept for every kind separately
+typedef enum {
+    MEMORY_UNIVERSE, // names of universe elements
+    MEMORY_ARRAY, // arrays of sets/relations
+    MEMORY_SET, // containers of set elements
+    MEMORY_RELATION, // relation pairs
+    MEMORY_INDEX, // CSR indexes of relations
+    MEMORY_TEMPORARY, // working memory of commands
+    MEMORY_KINDS // number of kinds
+} Memory_kind_t;
+
+// names of kinds of tracked blocks of memory (for the memory report)
+static const char *memory_kinds[] = {
+        "universe",
+        "array",
+        "set",
+        "relation",
+        "index",
+        "temporary"
+};
+
+// header in front of every tracked block of memory
+typedef union {
+    struct {
+        size_t size; // size of the block without the header
+        Memory_kind_t kind; // kind of the block
+        int refs; // number of sets/relations that share the block, it is freed when the last one frees it
+    } info;
+    long double align; // the block after the header is aligned for any type
+} Memory_header_t;
+
+// structure represents statistics and the limit of the tracked memory
+typedef struct {
+    size_t live; // bytes allocated now
+    size_t peak; // maximum of 'live'
+    size_t line_peak; // maximum of 'live' while the current line is processed
+    size_t kind_live[MEMORY_KINDS]; // 'live' of every kind
+    size_t kind_peak[MEMORY_KINDS]; // 'peak' of every kind
+    size_t limit; // 'live' can't be bigger than 'limit' (--max-memory=N, 0 if there is no limit)
+    bool isExceeded; // an allocation failed because of the limit
+    FILE *report; // statistics are printed there (--memory-report), NULL if they aren't printed
+} Memory_stats_t;
+
+// statistics of all memory allocated by the program
+static Memory_stats_t memory_stats;
+
+// structure represents a command over sets/relations (or both in case of "select")
+typedef struct {
+    char name[OPERATOR_BUFFER_SIZE]; // name of the command over sets/relations
+    int operands[MAX_OPERANDS_NUMBER]; // array of integers for keeping command operands
+    int nary_size; // number of operands of "union", "intersect" and "minus"
+    int nary_operands[MAX_NARY_OPERANDS_NUMBER]; // all operands of "union", "intersect" and "minus"
+} Command_t;
+
+// kinds of containers that keep elements (universe element ids) of a set
+// every set uses the smallest one, so its memory tracks the number of its elements
+typedef enum {
+    CONTAINER_ARRAY, // sorted array of element ids (sparse sets)
+    CONTAINER_BITMAP, // one bit for every universe element (dense sets)
+    CONTAINER_RUN // sorted array of runs of consecutive element ids (sets made of intervals)
+} Container_kind_t;
+
+// operations over two sets that produce a set
+typedef enum {
+    SET_UNION,
+    SET_INTERSECT,
+    SET_MINUS
+} Set_operation_t;
+
+// comparisons of two sets that produce true or false (in the same order as commands in set_commands after "minus")
+typedef enum {
+    SET_SUBSETEQ,
+    SET_SUBSET,
+    SET_EQUALS,
+    SET_COMPARISONS // number of comparisons
+} Set_comparison_t;
+
+// properties of a relation that are checked by commands (in the same order as commands in relation_commands)
+typedef enum {
+    PROPERTY_REFLEXIVE,
+    PROPERTY_SYMMETRIC,
+    PROPERTY_ANTISYMMETRIC,
+    PROPERTY_TRANSITIVE,
+    PROPERTY_FUNCTION,
+    PROPERTIES // number of properties
+} Property_t;
+
+// engines that implement operations over sets, checks of properties of relations and closures of relations
+typedef enum {
+    ENGINE_REFERENCE, // the original algorithms over lists of set elements and relation pairs
+    ENGINE_FAST, // algorithms over containers of sets and indexes and bitsets of relations
+    ENGINE_AUTO, // the reference engine for small operands, the fast engine for other ones
+    ENGINES // number of engines
+} Engine_kind_t;
+
+// names of engines (for --engine=NAME)
+static const char *engine_names[] = {
+        "reference",
+        "fast",
+        "auto"
+};
+
+// structure represents a set/relation
+// relations are never reordered after they were parsed/derived
+typedef struct {
+    int size; // number of relation pairs/set elements in relation/set
+    int id; // id of relation/set
+    bool isReleased; // elements were freed because no later line uses it (findById() doesn't find it anymore)
+
+    // relation pairs (x, y) given by ids of their elements, the i-th pair is (xs[i], ys[i]) (NULL for sets)
+    int *xs;
+    int *ys;
+
+    // names of universe elements (only the universal set), the element with id 'id' has a name names[id]
+    char **names;
+    char *name_data; // one block of memory that keeps all names
+    int *position_ids; // ids of universe elements in the order of the line "U" (only the universal set, NULL if the
+                       // line is sorted, then positions are ids)
+
+    // container of set elements
+    Container_kind_t kind;
+    uint32_t *ids; // sorted ids (CONTAINER_ARRAY) or first and last id of every run (CONTAINER_RUN)
+    int runs; // number of runs (CONTAINER_RUN)
+    uint64_t *bits; // bitmap of ids (CONTAINER_BITMAP)
+
+    // summary of set elements that answers many queries without touching the container
+    int min_id; // smallest id (-1 if the set is empty)
+    int max_id; // largest id (-1 if the set is empty)
+    uint64_t fingerprint; // bit (id % WORD_BITS) is set for every element id
+
+    // properties of the relation that are already known (a relation never changes, so every property is checked once)
+    // bit (1 << property) is set for every property
+    int known_properties; // properties that were checked or that follow from the way the relation was made
+    int properties; // known properties that hold
+
+    // compressed sparse row (CSR) indexes of the relation over universe element ids (NULL for sets)
+    // forward index: successors (y) of the element x are fwd_adj[fwd_start[x]] ... fwd_adj[fwd_start[x + 1] - 1]
+    // reverse index: predecessors (x) of the element y are rev_adj[rev_start[y]] ... rev_adj[rev_start[y + 1] - 1]
+    // both indexes are built only once and every row is sorted, so they can be read without mutating the relation
+    int *fwd_start;
+    int *fwd_adj;
+    int *rev_start;
+    int *rev_adj;
+} Relation_t;
+
+// structure represents a set/relation array
+typedef struct {
+    int size; // number of relations/sets in the array
+    Relation_t *relation_arr; // array of relations/sets
+} Relation_arr_t;
+
+// structure represents an iterator over set elements in ascending order of their ids
+typedef struct {
+    const Relation_t *set; // iterated set
+    int count; // number of already visited elements
+    int pos; // index of the current run (CONTAINER_RUN)
+    int id; // id of the current element
+} Set_iterator_t;
+
+// structure represents a node of a nested set expression, e.g. (intersect 2 (union 3 4))
+typedef struct {
+    int op; // index of the command in set_commands or -1 if the node is a set given by its id
+    int id; // id of the set (op == -1)
+    int child; // index of the first child node (-1 if there is no child)
+    int next; // index of the next sibling node (-1 if there is no sibling)
+    const uint64_t *bits; // bitmap of the set (op == -1)
+
+    // estimates of the set produced by the node, they are known before any set is touched
+    int min_size; // the set has at least min_size elements
+    int max_size; // the set has at most max_size elements
+    int first_word; // words of the bitmap before first_word are empty
+    int last_word; // words of the bitmap after last_word are empty
+} Expression_node_t;
+
+// structure represents a command with nested set expressions as its operands
+// the root node is the command itself, its children are its operands
+typedef struct {
+    int size; // number of nodes
+    Expression_node_t nodes[MAX_EXPRESSION_NODES];
+    int go_to_line; // go_to_line argument of the command (0 if there is not any)
+    int sample_size; // number of elements chosen by "sample"
+    int words; // number of words of bitmaps of the sets
+    uint64_t last_mask; // bits of the last word that belong to the universal set
+    uint64_t *leaf_bits; // bitmaps of sets that are not kept in a bitmap container
+} Expression_t;
+
+// structure represents a reader of lines of the file that reads the file ahead in big blocks
+typedef struct {
+    FILE *file; // file that is read
+    char buffer[READ_BUFFER_SIZE]; // block of the file that was read ahead
+    int pos; // index of the first character in the buffer that wasn't returned yet
+    int size; // number of characters in the buffer
+    long start; // offset of the first character of the buffer in the file
+} Line_reader_t;
+
+// structure represents the last use of every set/relation in the file
+// a set/relation is dead after its last use, so its memory can be freed before the end of the file
+// lines are only skipped forward (go_to_line), so a set/relation is dead also when its last use was skipped
+typedef struct {
+    bool isKnown; // the file could be read in advance (false if it can't be read again, e.g. a pipe)
+    int last_use[MAX_LINE_NUMBER + 1]; // number of the last line that uses the set/relation with the id (index)
+    int first_dead[MAX_LINE_NUMBER + 1]; // first id whose last use is the line (index), -1 if there isn't any
+    int next_dead[MAX_LINE_NUMBER + 1]; // next id with the same last use, -1 if there isn't any
+} Liveness_t;
+
+// structure represents an index of starts of lines in the file
+// lines skipped by go_to_line aren't read, the reader jumps straight to the start of the next processed line
+typedef struct {
+    bool isKnown; // the file could be read in advance (false if it can't be read again, e.g. a pipe)
+    int lines; // number of lines in the file
+    long offset[MAX_LINE_NUMBER + 1]; // offset of the start of the line (index) in the file (or of the end of the file)
+} Line_index_t;
+
+// structure represents a structure of a line found by one scan of the line
+typedef struct {
+    int length; // number of characters before '\n' (or before '\0')
+    bool isTerminated; // the line ends with '\n' (it isn't too long)
+    int delimiters; // number of delimiters (spaces)
+    bool hasDelimiterSequence; // two delimiters follow each other
+} Line_scan_t;
+
+// structure represents a partition of the universal set into equivalence classes
+typedef struct {
+    int size; // number of equivalence classes
+    int *class_of; // index of the class of every universe element
+    int *class_start; // members of the class c are members[class_start[c]] ... members[class_start[c + 1] - 1]
+    int *members; // universe element ids grouped by classes, sorted inside of every class
+} Partition_t;
+
+// structure represents a set calculator (see setcal.h)
+struct Setcal {
+    Relation_arr_t set_arr; // sets (the first one is the universal set)
+    Relation_arr_t relation_arr; // relations
+    int line_cnt; // number of processed lines
+    char last_line; // first character of the last processed line
+    int skip_lines; // how many lines must be skipped
+    FILE *output; // results of lines are printed there (NULL if they aren't printed)
+    FILE *errors; // errors are printed there (NULL if they aren't printed)
+    char error[ERROR_BUFFER_SIZE]; // errors of the last processed line
+    Setcal_result_t result; // result of the last processed line
+};
+
+// set calculator that processes a line now (results and errors of the line are written to it)
+static Setcal_t *active = NULL;
+
+// reports an error of the line that is processed now (arguments like printOutput())
+// the error is kept by the active set calculator and it is printed to its error stream
+static void reportError(const char *format, ...)
+{
+    if(active == NULL)
+        return;
+
+    va_list args;
+    size_t length = strlen(active->error);
+
+    va_start(args, format);
+    vsnprintf(&active->error[length], ERROR_BUFFER_SIZE - length, format, args);
+    va_end(args);
+
+    if(active->errors != NULL)
+    {
+        // results printed before the error must be written first (the output can be fully buffered)
+        if(active->output != NULL)
+            fflush(active->output);
+
+        va_start(args, format);
+        vfprintf(active->errors, format, args);
+        va_end(args);
+    }
+}
+
+// prints a result of the line that is processed now to the output of the active set calculator (like printOutput())
+static void printOutput(const char *format, ...)
+{
+    if(active == NULL || active->output == NULL)
+        return;
+
+    va_list args;
+
+    va_start(args, format);
+    vfprintf(active->output, format, args);
+    va_end(args);
+}
+
+// prints "true" or "false" and keeps it as the result of the line
+static void printBool(bool value)
+{
+    printOutput("%s\n", key_words[value]);
+
+    active->result.kind = SETCAL_RESULT_BOOL;
+    active->result.value = value;
+}
+
+// prints a number and keeps it as the result of the line
+static void printNumber(int number)
+{
+    printOutput("%d\n", number);
+
+    active->result.kind = SETCAL_RESULT_NUMBER;
+    active->result.number = number;
+}
+
+// adds 'size' bytes of the kind 'kind' to the statistics of the tracked memory
+static void memoryTrack(Memory_kind_t kind, size_t size)
+{
+    memory_stats.live += size;
+    memory_stats.kind_live[kind] += size;
+
+    if(memory_stats.live > memory_stats.peak)
+        memory_stats.peak = memory_stats.live;
+
+    if(memory_stats.live > memory_stats.line_peak)
+        memory_stats.line_peak = memory_stats.live;
+
+    if(memory_stats.kind_live[kind] > memory_stats.kind_peak[kind])
+        memory_stats.kind_peak[kind] = memory_stats.kind_live[kind];
+}
+
+// removes 'size' bytes of the kind 'kind' from the statistics of the tracked memory
+static void memoryUntrack(Memory_kind_t kind, size_t size)
+{
+    memory_stats.live -= size;
+    memory_stats.kind_live[kind] -= size;
+}
+
+// checks if 'size' more bytes can be allocated without exceeding the memory limit
+static bool memoryAvailable(size_t size)
+{
+    if(memory_stats.limit == 0 || memory_stats.live + size <= memory_stats.limit)
+        return true;
+
+    memory_stats.isExceeded = true;
+    return false;
+}
+
+// allocates a tracked block of memory of the kind 'kind' (like malloc())
+// returns NULL if there is no memory or if the block would exceed the memory limit
+static void *trackedMalloc(size_t size, Memory_kind_t kind)
+{
+    if(!memoryAvailable(size))
+        return NULL;
+
+    Memory_header_t *h = (Memory_header_t *) malloc(sizeof(Memory_header_t) + size);
+
+    if(h == NULL)
+        return NULL;
+
+    h->info.size = size;
+    h->info.kind = kind;
+    h->info.refs = 1;
+    memoryTrack(kind, size);
+
+    return h + 1;
+}
+
+// shares a tracked block of memory with one more owner and returns it (the block is counted only once)
+static void *trackedShare(void *ptr)
+{
+    if(ptr != NULL)
+        ((Memory_header_t *) ptr - 1)->info.refs++;
+
+    return ptr;
+}
+
+// allocates a tracked block of memory of the kind 'kind' for 'n' items of size 'size' set to zero (like calloc())
+static void *trackedCalloc(size_t n, size_t size, Memory_kind_t kind)
+{
+    void *ptr = trackedMalloc(n * size, kind);
+
+    if(ptr != NULL)
+        memset(ptr, 0, n * size);
+
+    return ptr;
+}
+
+// resizes a tracked block of memory (like realloc()), the original block stays allocated if it fails
+static void *trackedRealloc(void *ptr, size_t size, Memory_kind_t kind)
+{
+    if(ptr == NULL)
+        return trackedMalloc(size, kind);
+
+    Memory_header_t *h = (Memory_header_t *) ptr - 1;
+    size_t old_size = h->info.size;
+
+    if(h->info.refs > 1) // copy on write: the block is shared, so the owner gets its own copy
+    {
+        void *copy = trackedMalloc(size, kind);
+
+        if(copy == NULL)
+            return NULL;
+
+        memcpy(copy, ptr, old_size < size ? old_size : size);
+        h->info.refs--;
+        return copy;
+    }
+
+    if(size > old_size && !memoryAvailable(size - old_size))
+        return NULL;
+
+    Memory_header_t *tmp = (Memory_header_t *) realloc(h, sizeof(Memory_header_t) + size);
+
+    if(tmp == NULL)
+        return NULL;
+
+    memoryUntrack(tmp->info.kind, old_size);
+    tmp->info.size = size;
+    tmp->info.kind = kind;
+    memoryTrack(kind, size);
+
+    return tmp + 1;
+}
+
+// frees a tracked block of memory (like free())
+static void trackedFree(void *ptr)
+{
+    if(ptr == NULL)
+        return;
+
+    Memory_header_t *h = (Memory_header_t *) ptr - 1;
+
+    if(--h->info.refs != 0) // the block is still shared by another set/relation
+        return;
+
+    memoryUntrack(h->info.kind, h->info.size);
+    free(h);
+}
+
+// prints the peak of the tracked memory of every kind and of the whole program to the stream 'f' (--memory-report)
+static void printMemoryReport(FILE *f)
+{
+    if(memory_stats.report == NULL)
+        return;
+
+    for(int kind = 0; kind < MEMORY_KINDS; kind++)
+        fprintf(f, "Memory: %s: peak %lu B\n", memory_kinds[kind], (unsigned long) memory_stats.kind_peak[kind]);
+
+    fprintf(f, "Memory: total: peak %lu B\n", (unsigned long) memory_stats.peak);
+}
+
+// initializes a relation/set
+static void relationCtor(Relation_t *r, int id)
+{
+    r->id = id;
+    r->size = 0;
+    r->isReleased = false;
+    r->xs = NULL;
+    r->ys = NULL;
+    r->names = NULL;
+    r->name_data = NULL;
+    r->position_ids = NULL;
+    r->kind = CONTAINER_ARRAY;
+    r->ids = NULL;
+    r->runs = 0;
+    r->bits = NULL;
+    r->min_id = -1;
+    r->max_id = -1;
+    r->fingerprint = 0;
+    r->known_properties = 0;
+    r->properties = 0;
+    r->fwd_start = NULL;
+    r->fwd_adj = NULL;
+    r->rev_start = NULL;
+    r->rev_adj = NULL;
+}
+
+// frees the memory allocated for a relation/set elements, but keeps its id (so the array stays sorted by ids)
+// the relation/set is marked as released, findById() treats it as missing
+static void relationRelease(Relation_t *r)
+{
+    if(r != NULL)
+    {
+        r->isReleased = true;
+
+        // free relation pairs
+        trackedFree(r->xs);
+        trackedFree(r->ys);
+        r->xs = r->ys = NULL;
+
+        // free names of universe elements
+        trackedFree(r->names);
+        trackedFree(r->name_data);
+        trackedFree(r->position_ids);
+        r->names = NULL;
+        r->name_data = NULL;
+        r->position_ids = NULL;
+
+        // free a container of set elements
+        trackedFree(r->ids);
+        trackedFree(r->bits);
+        r->ids = NULL;
+        r->bits = NULL;
+
+        // free CSR indexes of the relation
+        trackedFree(r->fwd_start);
+        trackedFree(r->fwd_adj);
+        trackedFree(r->rev_start);
+        trackedFree(r->rev_adj);
+        r->fwd_start = r->fwd_adj = r->rev_start = r->rev_adj = NULL;
+
+        r->size = 0;
+    }
+}
+
+// makes the relation/set 'new' equal to the relation/set 'r' without copying its elements
+// 'new' shares all memory blocks of 'r' (relations/sets are never changed after they were created), 'new' keeps its id
+static void relationShare(Relation_t *new, const Relation_t *r)
+{
+    new->size = r->size;
+    new->xs = (int *) trackedShare(r->xs);
+    new->ys = (int *) trackedShare(r->ys);
+    new->kind = r->kind;
+    new->ids = (uint32_t *) trackedShare(r->ids);
+    new->runs = r->runs;
+    new->bits = (uint64_t *) trackedShare(r->bits);
+    new->min_id = r->min_id;
+    new->max_id = r->max_id;
+    new->fingerprint = r->fingerprint;
+    new->known_properties = r->known_properties;
+    new->properties = r->properties;
+    new->fwd_start = (int *) trackedShare(r->fwd_start);
+    new->fwd_adj = (int *) trackedShare(r->fwd_adj);
+    new->rev_start = (int *) trackedShare(r->rev_start);
+    new->rev_adj = (int *) trackedShare(r->rev_adj);
+}
+
+// frees the memory allocated for a relation/set
+static void relationDtor(Relation_t *r)
+{
+    relationRelease(r);
+
+    r->size = 0;
+    r->id = 0;
+}
+
+// initializes an array of relations/sets
+static void relationArrayCtor(Relation_arr_t *a)
+{
+    a->size = 0;
+    a->relation_arr = NULL;
+}
+
+// frees the memory allocated for a relation/set array
+static void relationArrayDtor(Relation_arr_t *a)
+{
+    if(a != NULL)
+    {
+        for(int i = 0; i < a->size; i++)
+            relationDtor(&a->relation_arr[i]); // free every single relation/set of the relation/set array
+
+        trackedFree(a->relation_arr); // free an array of relations/sets
+        a->relation_arr = NULL; // set a pointer to NULL
+    }
+
+    a->size = 0;
+}
+
+// resizes a relation/set array
+// if it fails, the array keeps its original block of memory and all its relations/sets
+static void *relationArrayResize(Relation_arr_t *a, int new_size)
+{
+    // allocate a new block of memory with a desired size
+    Relation_t *tmp = (Relation_t *) trackedRealloc(a->relation_arr, new_size * sizeof(Relation_t), MEMORY_ARRAY);
+
+    if(tmp == NULL) // realloc failed
+        return NULL;
+
+    a->size = new_size; // set a new size
+    a->relation_arr = tmp; // assign an allocated block of memory
+
+    return a;
+}
+
+// returns a number of words of a bitset that can hold 'n' bits
+static int bitsetWords(int n)
+{
+    return (n + WORD_BITS - 1) / WORD_BITS;
+}
+
+// checks if bit 'i' of the bitset is set
+static bool bitsetTest(const uint64_t *bits, int i)
+{
+    return (bits[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+}
+
+// sets bit 'i' of the bitset
+static void bitsetSet(uint64_t *bits, int i)
+{
+    bits[i / WORD_BITS] |= (uint64_t) 1 << (i % WORD_BITS);
+}
+
+// returns a number of bits set in the word
+static int popcount(uint64_t x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+    return (int) ((x * 0x0101010101010101ULL) >> 56);
+}
+
+// returns an index of the lowest bit set in the word (the word must not be 0)
+static int lowestBit(uint64_t x)
+{
+    return popcount((x & -x) - 1); // bits below the lowest set bit
+}
+
+// returns bits of the last word of a bitset of 'n' bits that belong to the bitset
+static uint64_t bitsetLastMask(int n)
+{
+    return n % WORD_BITS == 0 ? ~(uint64_t) 0 : ((uint64_t) 1 << (n % WORD_BITS)) - 1;
+}
+
+// returns a number of bits set in the bitset of 'words' words
+static int bitsetCount(const uint64_t *bits, int words)
+{
+    int count = 0;
+
+    for(int w = 0; w < words; w++)
+        count += popcount(bits[w]);
+
+    return count;
+}
+
+// combines the bitset 'bits' into the bitset 'acc' by the operation 'op' word by word
+// returns false if 'acc' is empty after that (an intersection/difference can't get any element back)
+static bool bitsetCombine(uint64_t *acc, const uint64_t *bits, int words, Set_operation_t op)
+{
+    uint64_t any = 0;
+
+    for(int w = 0; w < words; w++)
+    {
+        if(op == SET_UNION)
+            acc[w] |= bits[w];
+        else if(op == SET_INTERSECT)
+            acc[w] &= bits[w];
+        else
+            acc[w] &= ~bits[w];
+
+        any |= acc[w];
+    }
+
+    return any != 0;
+}
+
+// checks if the bitset 'a' is a subset of the bitset 'b' looking only at words 'first' ... 'last'
+// stops on the first word with a bit that is not set in the bitset 'b'
+static bool bitsetSubset(const uint64_t *a, const uint64_t *b, int first, int last)
+{
+    for(int w = first; w <= last; w++)
+        if((a[w] & ~b[w]) != 0)
+            return false;
+
+    return true;
+}
+
+// compares two integers (for qsort() function)
+static int compareInt(const void *a, const void *b)
+{
+    return *(const int *) a - *(const int *) b;
+}
+
+// compares two element ids (for qsort() function)
+static int compareId(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+// returns a number of runs of consecutive ids in the sorted array of ids
+static int countRuns(const uint32_t *ids, int size)
+{
+    int runs = 0;
+
+    for(int i = 0; i < size; i++)
+        if(i == 0 || ids[i] != ids[i - 1] + 1)
+            runs++;
+
+    return runs;
+}
+
+// initializes an empty set 's' from 'size' sorted unique ids
+// chooses the smallest container: array (4 bytes per element), bitmap (1 bit per universe element)
+// or runs (8 bytes per run of consecutive ids)
+// the container depends only on the ids, so equal sets always have the same kind of container with the same content
+static bool setFromIds(Relation_t *s, const uint32_t *ids, int size, int universe_size)
+{
+    int runs = countRuns(ids, size);
+
+    long array_bytes = (long) size * sizeof(uint32_t);
+    long bitmap_bytes = (long) bitsetWords(universe_size) * sizeof(uint64_t);
+    long run_bytes = (long) runs * 2 * sizeof(uint32_t);
+
+    s->size = size;
+    s->min_id = size != 0 ? (int) ids[0] : -1;
+    s->max_id = size != 0 ? (int) ids[size - 1] : -1;
+    s->fingerprint = 0;
+
+    for(int i = 0; i < size; i++)
+        s->fingerprint |= (uint64_t) 1 << (ids[i] % WORD_BITS);
+
+    if(array_bytes <= bitmap_bytes && array_bytes <= run_bytes)
+    {
+        s->kind = CONTAINER_ARRAY;
+        s->ids = (uint32_t *) trackedMalloc((size + 1) * sizeof(uint32_t), MEMORY_SET);
+
+        if(s->ids != NULL && size != 0)
+            memcpy(s->ids, ids, size * sizeof(uint32_t));
+    }
+    else if(run_bytes <= bitmap_bytes)
+    {
+        s->kind = CONTAINER_RUN;
+        s->runs = runs;
+        s->ids = (uint32_t *) trackedMalloc(2 * runs * sizeof(uint32_t), MEMORY_SET);
+
+        for(int i = 0, run = -1; s->ids != NULL && i < size; i++)
+        {
+            if(i == 0 || ids[i] != ids[i - 1] + 1) // a new run starts
+                s->ids[2 * ++run] = ids[i];
+
+            s->ids[2 * run + 1] = ids[i]; // last id of the run
+        }
+    }
+    else
+    {
+        s->kind = CONTAINER_BITMAP;
+        s->bits = (uint64_t *) trackedCalloc(bitsetWords(universe_size), sizeof(uint64_t), MEMORY_SET);
+
+        for(int i = 0; s->bits != NULL && i < size; i++)
+            bitsetSet(s->bits, ids[i]);
+    }
+
+    if(s->ids == NULL && s->bits == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    return true;
+}
+
+// initializes an empty set 's' from the bitset of ids
+// ids are extracted word by word, so empty words are skipped at once
+static bool setFromBitset(Relation_t *s, const uint64_t *bits, int universe_size)
+{
+    int words = bitsetWords(universe_size);
+    uint32_t *ids = (uint32_t *) trackedMalloc((bitsetCount(bits, words) + 1) * sizeof(uint32_t), MEMORY_TEMPORARY);
+
+    if(ids == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    int size = 0;
+
+    for(int w = 0; w < words; w++)
+        for(uint64_t word = bits[w]; word != 0; word &= word - 1) // clear the lowest bit set
+            ids[size++] = w * WORD_BITS + lowestBit(word);
+
+    bool result = setFromIds(s, ids, size, universe_size);
+
+    trackedFree(ids);
+    return result;
+}
+
+// initializes an iterator over elements of the set 's'
+static void setIteratorCtor(Set_iterator_t *it, const Relation_t *s)
+{
+    it->set = s;
+    it->count = 0;
+    it->pos = 0;
+    it->id = -1;
+}
+
+// moves an iterator to the next element of the set, returns false if all elements were visited
+static bool setIteratorNext(Set_iterator_t *it)
+{
+    const Relation_t *s = it->set;
+
+    if(it->count == s->size)
+        return false;
+
+    if(s->kind == CONTAINER_ARRAY)
+        it->id = s->ids[it->count];
+    else if(s->kind == CONTAINER_RUN)
+    {
+        if(it->id == -1) // first element of the first run
+            it->id = s->ids[0];
+        else if((uint32_t) it->id == s->ids[2 * it->pos + 1]) // first element of the next run
+            it->id = s->ids[2 * ++it->pos];
+        else
+            it->id++;
+    }
+    else
+    {
+        // find the lowest bit set after the current element, the rest of its word is masked out at once
+        int next = it->id + 1;
+        int w = next / WORD_BITS;
+        uint64_t word = s->bits[w] & (~(uint64_t) 0 << (next % WORD_BITS));
+
+        while(word == 0) // there is one more element, so some next word isn't empty
+            word = s->bits[++w];
+
+        it->id = w * WORD_BITS + lowestBit(word);
+    }
+
+    it->count++;
+    return true;
+}
+
+// checks if the element with id 'id' belongs to the set 's'
+static bool setContains(const Relation_t *s, int id)
+{
+    if(s->kind == CONTAINER_BITMAP)
+        return bitsetTest(s->bits, id);
+
+    // binary search over sorted ids or over sorted runs
+    int step = s->kind == CONTAINER_RUN ? 2 : 1;
+    int l = 0;
+    int h = (s->kind == CONTAINER_RUN ? s->runs : s->size) - 1;
+
+    while(l <= h)
+    {
+        int m = (l + h) / 2;
+
+        if((uint32_t) id < s->ids[m * step])
+            h = m - 1;
+        else if((uint32_t) id > s->ids[m * step + step - 1])
+            l = m + 1;
+        else
+            return true;
+    }
+
+    return false;
+}
+
+// writes elements of the set 's' to the bitset 'bits' of 'words' words
+static void setToBitset(const Relation_t *s, uint64_t *bits, int words)
+{
+    if(s->kind == CONTAINER_BITMAP)
+    {
+        memcpy(bits, s->bits, words * sizeof(uint64_t));
+        return;
+    }
+
+    memset(bits, 0, words * sizeof(uint64_t));
+
+    Set_iterator_t it;
+    setIteratorCtor(&it, s);
+
+    while(setIteratorNext(&it))
+        bitsetSet(bits, it.id);
+}
+
+// returns an id of the k-th smallest element of the set 's'
+static int setElementAt(const Relation_t *s, int k)
+{
+    if(s->kind == CONTAINER_ARRAY)
+        return s->ids[k];
+
+    Set_iterator_t it;
+    setIteratorCtor(&it, s);
+
+    while(setIteratorNext(&it) && k != 0)
+        k--;
+
+    return it.id;
+}
+
+// prints a set
+static void printSet(const Relation_t *s, const Relation_t *universal_set)
+{
+    if(s->id != 1)
+        printOutput("S");
+    else
+        printOutput("U");
+
+    Set_iterator_t it;
+    setIteratorCtor(&it, s);
+
+    while(setIteratorNext(&it))
+        printOutput(" %s", universal_set->names[it.id]);
+
+    printOutput("\n");
+}
+
+// prints a relation
+static void printRelation(const Relation_t *r, const Relation_t *universal_set)
+{
+    printOutput("R");
+
+    for(int i = 0; i < r->size; i++)
+        printOutput(" (%s %s)", universal_set->names[r->xs[i]], universal_set->names[r->ys[i]]);
+
+    printOutput("\n");
+}
+
+//void printSetArray(Relation_arr_t *a)
+//{
+//    for(int i = 0; i < a->size; i++)
+//        printSet(&a->relation_arr[i]);
+//
+//}
+////
+//void printRelationArray(Relation_arr_t *a)
+//{
+//    for(int i = 0; i < a->size; i++)
+//        printRelation(&a->relation_arr[i]);
+//}
+
+// returns a word with the highest bit set in every byte of 'word' that is equal to 'c' (other bits are 0)
+static uint64_t byteMask(uint64_t word, unsigned char c)
+{
+    uint64_t t = word ^ (BYTE_ONES * c); // bytes equal to 'c' are 0
+
+    return ~(((t & LOW_BITS) + LOW_BITS) | t | LOW_BITS);
+}
+
+// loads at most WORD_BYTES characters of the string 'str' to one word (the first character is the lowest byte)
+// missing characters are 0, so they end the line like '\0'
+static uint64_t loadWord(const char *str, int count)
+{
+    uint64_t word = 0;
+
+    for(int i = 0; i < count && i < WORD_BYTES; i++)
+        word |= (uint64_t) (unsigned char) str[i] << (i * 8);
+
+    return word;
+}
+
+// scans 'size' characters of the line (as they were read by readLine()) WORD_BYTES characters at a time
+// finds the end of the line, counts delimiters and finds two delimiters following each other in one pass
+// '\n' at the end of the line is replaced by '\0' because we don't need it
+static void scanLine(char *line, int size, Line_scan_t *scan)
+{
+    uint64_t last_delimiter = 0; // the last character of the previous word was a delimiter
+
+    scan->delimiters = 0;
+    scan->hasDelimiterSequence = false;
+    scan->length = size;
+
+    for(int i = 0; i < size; i += WORD_BYTES)
+    {
+        uint64_t word = loadWord(&line[i], size - i);
+        uint64_t delimiters = byteMask(word, DELIMITER_CHAR);
+        uint64_t ends = byteMask(word, '\n') | byteMask(word, '\0');
+
+        if(ends != 0) // the line ends in this word, characters after its end don't belong to the line
+        {
+            int end = lowestBit(ends) / 8;
+
+            delimiters &= end == 0 ? 0 : ~(uint64_t) 0 >> (WORD_BITS - end * 8);
+            scan->length = i + end;
+        }
+
+        scan->delimiters += popcount(delimiters);
+
+        if((delimiters & (delimiters >> 8)) != 0 || (last_delimiter && (delimiters & 0x80) != 0))
+            scan->hasDelimiterSequence = true;
+
+        last_delimiter = delimiters >> (WORD_BITS - 1);
+
+        if(ends != 0)
+            break;
+    }
+
+    scan->isTerminated = scan->length < size && line[scan->length] == '\n';
+    line[scan->length] = '\0';
+}
+
+// checks the right order of the lines in the file
+static bool isValidSequence(char current_line, char *last_line, int line_cnt)
+{
+    if(line_cnt == 0) // first line must 'declare' a universal set (i.e. must start from the character 'U')
+    {
+        if(current_line == 'U')
+        {
+            *last_line = current_line; // writes a first character of the line to the *last_line
+            return true;
+        }
+
+        return false;
+    }
+
+    // right order of the lines in the file: U -> R/S -> C
+    switch (*last_line)
+    {
+        case 'U':
+            if(current_line != 'R' && current_line != 'S')
+                return false;
+            break;
+
+        case 'R':
+        case 'S':
+            if(current_line != 'R' && current_line != 'S' && current_line != 'C')
+                return false;
+            break;
+
+        case 'C':
+            if(current_line != 'C')
+                return false;
+            break;
+    }
+
+    *last_line = current_line; // writes a first character of the line to the *last_line
+    return true;
+}
+
+// checks if a line gives a set/relation by positions of its elements in the line "U" ("S#" or "R#")
+static bool isPositionLine(const char *line)
+{
+    return (line[0] == 'S' || line[0] == 'R') && line[1] == POSITION_FORMAT_CHAR;
+}
+
+// checks if a line from the file ('size' characters as they were read) is valid
+// the structure of the line found by its scan is written to 'scan'
+static bool isValidLine(char *line, int size, int line_cnt, char *last_line, Line_scan_t *scan)
+{
+    scanLine(line, size, scan);
+
+    // the line must end with '\n' (i.e. it isn't too long) and it must not be empty
+    // if line contains a command over sets/relations its length must be greater or equal to 8
+    // because strlen("C card 1") == 8 and card is 'the shortest' command
+    if(!scan->isTerminated || scan->length == 0 || (*line == 'C' && scan->length < 8))
+    {
+        reportError("Error! Invalid line no. %d length\n", line_cnt + 1);
+        return false;
+    }
+
+    // check if line doesn't contain a delimiter (space) as its last character
+    if(line[scan->length - 1] == DELIMITER_CHAR)
+    {
+        reportError("Error! Delimiter (space) must not be the last character of the line (line no. %d)\n", line_cnt + 1);
+        return false;
+    }
+
+    if(!isValidSequence(line[0], last_line, line_cnt))
+    {
+        reportError("Error! Invalid file format: it must be like that: U -> R/S -> C (line no. %d)\n", line_cnt + 1);
+        return false;
+    }
+
+    int prefix = isPositionLine(line) ? 2 : 1; // length of "S", "R", "S#", ...
+
+    if(line[prefix] == '\0') // in the case when a set/relation is empty
+        return true;
+
+    // if a set/relation is not empty there should be a delimiter (space) as a second character of the line
+    // ("S#" and "R#" lines have it as a third character)
+    if(line[prefix] != DELIMITER_CHAR)
+    {
+        reportError("Error! If line doesn't declare an empty set/relation,"
+                        "there should be a space (delimiter) as a second character (line no. %d)\n", line_cnt + 1);
+        return false;
+    }
+
+    if(!scan->hasDelimiterSequence)
+        return true;
+
+    reportError("Error! Line no. %d contains two or more delimiters (spaces) following each other\n", line_cnt + 1);
+    return false;
+}
+
+// checks if each character from the string is an alphabetic
+static bool isOnlyAlpha(char *str)
+{
+    for(int i = 0; str[i] != '\0'; i++)
+        if(!isalpha((int) str[i]))
+            return false;
+
+    return true;
+}
+
+// checks if string contains a command over sets/relations
+static bool isCommand(char *str)
+{
+    for(int i = 0; i < ARRAY_SIZE(set_commands); i++)
+        if(strcmp(str, set_commands[i]) == 0)
+            return true;
+
+    for(int i = 0; i < ARRAY_SIZE(relation_commands); i++)
+        if(strcmp(str, relation_commands[i]) == 0)
+            return true;
+
+    return false;
+}
+
+// checks if string contains a keyword "true" or "false"
+static bool isKeyWord(char *str)
+{
+    return strcmp(str, key_words[0]) == 0 || strcmp(str, key_words[1]) == 0;
+}
+
+// checks if string contains a valid set element
+static bool isValidSetElement(char *str)
+{
+    return strlen(str) <= MAX_SET_ELEMENT_LENGTH && isOnlyAlpha(str) && !isCommand(str) &&
+           !isKeyWord(str);
+}
+
+// returns the next token (a string between delimiters) starting at '*pos' and terminates it by '\0'
+// '*pos' moves after the token, returns NULL if there isn't any token more
+// unlike strtok() it keeps no hidden state, so any number of lines can be tokenized at the same time
+static char *nextToken(char **pos)
+{
+    char *token = *pos + strspn(*pos, DELIMITER_STR);
+
+    if(*token == '\0')
+        return NULL;
+
+    char *end = token + strcspn(token, DELIMITER_STR);
+    *pos = *end != '\0' ? end + 1 : end;
+    *end = '\0';
+
+    return token;
+}
+
+// compares names of two set elements (for qsort() function)
+static int compareNames(const void *a, const void *b)
+{
+    return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+// checks if sorted names contain a duplicate
+static bool containDuplicateName(char **names, int size)
+{
+    for(int i = 0; i < size - 1; i++)
+        if(strcmp(names[i], names[i + 1]) == 0)
+            return true;
+
+    return false;
+}
+
+
+// returns an id of the element with name 'name', i.e. its index in the (sorted) universal set
+// uses binary search algorithm, returns -1 if the element doesn't belong to the universal set
+static int elementId(const Relation_t *universal, const char *name)
+{
+    int l = 0;
+    int h = universal->size - 1;
+
+    while(l <= h)
+    {
+        int m = (l + h) / 2;
+        int compare = strcmp(name, universal->names[m]);
+
+        if(compare > 0)
+            l = m + 1;
+        else if(compare < 0)
+            h = m - 1;
+        else
+            return m;
+    }
+
+    return -1;
+}
+
+// builds a forward (by x) and a reverse (by y) CSR index of the relation 'r'
+// uses two passes of counting sort over universe element ids, so every row of both indexes is sorted
+static bool relationIndexCtor(Relation_t *r, const Relation_t *universal)
+{
+    int n = universal->size;
+
+    const int *xs = r->xs; // ids of first elements of relation pairs
+    const int *ys = r->ys; // ids of second elements of relation pairs
+    int *order = (int *) trackedMalloc((r->size + 1) * sizeof(int), MEMORY_TEMPORARY); // indexes of relation pairs sorted by y
+    int *cursor = (int *) trackedMalloc((n + 1) * sizeof(int), MEMORY_TEMPORARY); // next free position in every row
+
+    r->fwd_start = (int *) trackedCalloc(n + 1, sizeof(int), MEMORY_INDEX);
+    r->rev_start = (int *) trackedCalloc(n + 1, sizeof(int), MEMORY_INDEX);
+    r->fwd_adj = (int *) trackedMalloc((r->size + 1) * sizeof(int), MEMORY_INDEX);
+    r->rev_adj = (int *) trackedMalloc((r->size + 1) * sizeof(int), MEMORY_INDEX);
+
+    if(order == NULL || cursor == NULL || r->fwd_start == NULL || r->rev_start == NULL || r->fwd_adj == NULL ||
+       r->rev_adj == NULL)
+    {
+        trackedFree(order);
+        trackedFree(cursor);
+        reportError("Error! Couldn't allocate memory for a relation index\n");
+        return false;
+    }
+
+    for(int i = 0; i < r->size; i++)
+    {
+        // count a size of every row
+        r->fwd_start[xs[i] + 1]++;
+        r->rev_start[ys[i] + 1]++;
+    }
+
+    // prefix sums of the row sizes are the row offsets
+    for(int i = 0; i < n; i++)
+    {
+        r->fwd_start[i + 1] += r->fwd_start[i];
+        r->rev_start[i + 1] += r->rev_start[i];
+    }
+
+    // first pass: order relation pairs by y
+    memcpy(cursor, r->rev_start, n * sizeof(int));
+
+    for(int i = 0; i < r->size; i++)
+        order[cursor[ys[i]]++] = i;
+
+    // second pass: fill forward rows in order of y, so every forward row is sorted
+    memcpy(cursor, r->fwd_start, n * sizeof(int));
+
+    for(int i = 0; i < r->size; i++)
+        r->fwd_adj[cursor[xs[order[i]]]++] = ys[order[i]];
+
+    // fill reverse rows in order of x, so every reverse row is sorted
+    memcpy(cursor, r->rev_start, n * sizeof(int));
+
+    for(int x = 0; x < n; x++)
+        for(int i = r->fwd_start[x]; i < r->fwd_start[x + 1]; i++)
+            r->rev_adj[cursor[r->fwd_adj[i]]++] = x;
+
+    trackedFree(order);
+    trackedFree(cursor);
+    return true;
+}
+
+// returns a number of successors of the element with id 'x' in the relation 'r'
+static int outDegree(const Relation_t *r, int x)
+{
+    return r->fwd_start[x + 1] - r->fwd_start[x];
+}
+
+// returns a number of predecessors of the element with id 'y' in the relation 'r'
+static int inDegree(const Relation_t *r, int y)
+{
+    return r->rev_start[y + 1] - r->rev_start[y];
+}
+
+// checks if there is a relation pair (x, y) in the relation 'r' using binary search in the forward row of 'x'
+static bool hasPair(const Relation_t *r, int x, int y)
+{
+    int l = r->fwd_start[x];
+    int h = r->fwd_start[x + 1] - 1;
+
+    while(l <= h)
+    {
+        int m = (l + h) / 2;
+
+        if(y > r->fwd_adj[m])
+            l = m + 1;
+        else if(y < r->fwd_adj[m])
+            h = m - 1;
+        else
+            return true;
+    }
+
+    return false;
+}
+
+// parses a universal set from the file
+// the universal set keeps names of its elements (sorted), index of the name is an id of the element
+// all names stay in one block of memory, they are just separated by '\0'
+static bool parseUniverse(char *line, int delimiters, Relation_t *u)
+{
+    // if line declaring a set has a right format (U element1 element2 ...)
+    // there are a 'delimiters' set elements
+    u->names = (char **) trackedMalloc((delimiters + 1) * sizeof(char *), MEMORY_UNIVERSE);
+    u->name_data = (char *) trackedMalloc(strlen(line + 2) + 1, MEMORY_UNIVERSE);
+
+    if(u->names == NULL || u->name_data == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    strcpy(u->name_data, line + 2);
+
+    char *pos = u->name_data;
+    int size = 0;
+
+    // get set elements one by one
+    for(char *token = nextToken(&pos); token != NULL; token = nextToken(&pos))
+    {
+        if(!isValidSetElement(token))
+        {
+            reportError("Error! Invalid set element '%s'\n", token);
+            return false;
+        }
+
+        u->names[size++] = token;
+    }
+
+    // names in the order of the line (they are needed to find ids of positions of elements)
+    char **line_names = (char **) trackedMalloc((size + 1) * sizeof(char *), MEMORY_TEMPORARY);
+    u->position_ids = (int *) trackedMalloc((size + 1) * sizeof(int), MEMORY_UNIVERSE);
+
+    if(line_names == NULL || u->position_ids == NULL)
+    {
+        trackedFree(line_names);
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    memcpy(line_names, u->names, size * sizeof(char *));
+    qsort(u->names, size, sizeof(char *), compareNames); // sort a set
+
+    // check if set contains a duplicate elements or not
+    if(containDuplicateName(u->names, size))
+    {
+        trackedFree(line_names);
+        reportError("Error! Each set element must be unique\n");
+        return false;
+    }
+
+    u->size = size; // elementId() searches 'size' names
+    bool isSorted = true; // the line "U" is sorted, so positions of elements are their ids
+
+    for(int i = 0; i < size; i++)
+    {
+        u->position_ids[i] = elementId(u, line_names[i]);
+        isSorted = isSorted && u->position_ids[i] == i;
+    }
+
+    trackedFree(line_names);
+
+    if(isSorted)
+    {
+        trackedFree(u->position_ids);
+        u->position_ids = NULL;
+    }
+
+    // the universal set contains all ids
+    uint32_t *ids = (uint32_t *) trackedMalloc((size + 1) * sizeof(uint32_t), MEMORY_TEMPORARY);
+
+    if(ids == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    for(int id = 0; id < size; id++)
+        ids[id] = id;
+
+    bool result = setFromIds(u, ids, size, size);
+
+    trackedFree(ids);
+    return result;
+}
+
+// checks if sorted ids contain a duplicate
+static bool containDuplicateId(const uint32_t *ids, int size)
+{
+    for(int i = 0; i < size - 1; i++)
+        if(ids[i] == ids[i + 1])
+            return true;
+
+    return false;
+}
+
+// returns a position of a universe element given by the token 'token' (only digits, less than the size of the
+// universe), -1 if it isn't a valid position
+static int parsePosition(const Relation_t *universal, const char *token)
+{
+    int length = strlen(token);
+
+    if(length == 0 || length > MAX_POSITION_LENGTH || strspn(token, "0123456789") != (size_t) length)
+        return -1;
+
+    int position = atoi(token);
+
+    return position < universal->size ? position : -1;
+}
+
+// returns an id of the universe element on the position 'position' of the line "U"
+static int positionId(const Relation_t *universal, int position)
+{
+    return universal->position_ids != NULL ? universal->position_ids[position] : position;
+}
+
+// parses a set given by positions of its elements in the line "U" (a line "S# position1 position2 ...")
+// ascending positions are unique, so they aren't checked for duplicates, and if the line "U" is sorted too, they are
+// already sorted ids, so only positions out of range are checked
+static bool parseSetPositions(char *line, int delimiters, Relation_t *s, const Relation_t *universal)
+{
+    uint32_t *ids = (uint32_t *) trackedMalloc((delimiters + 1) * sizeof(uint32_t), MEMORY_TEMPORARY);
+
+    if(ids == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    char *pos = line + 2; // after "S#"
+    int size = 0;
+    int last_position = -1; // position of the previous element
+    bool isSorted = true; // positions are ascending (so they are unique too)
+
+    for(char *token = nextToken(&pos); token != NULL; token = nextToken(&pos), size++)
+    {
+        int position = parsePosition(universal, token);
+
+        if(position == -1)
+        {
+            reportError("Error! Invalid position of a universe element '%s'\n", token);
+            trackedFree(ids);
+            return false;
+        }
+
+        isSorted = isSorted && position > last_position;
+        last_position = position;
+        ids[size] = positionId(universal, position);
+    }
+
+    if(!isSorted || universal->position_ids != NULL)
+        qsort(ids, size, sizeof(uint32_t), compareId); // sort a set
+
+    if(!isSorted && containDuplicateId(ids, size))
+    {
+        reportError("Error! Each set element must be unique\n");
+        trackedFree(ids);
+        return false;
+    }
+
+    bool result = setFromIds(s, ids, size, universal->size);
+    trackedFree(ids);
+
+    if(result)
+        printSet(s, universal);
+
+    return result;
+}
+
+// parses a set from the file
+// 'delimiters' is a number of delimiters (spaces) in the line
+static bool parseSet(char *line, int delimiters, Relation_arr_t *set_arr, int line_cnt)
+{
+    // resizes an array of sets in order to be able to store one more set, i.e. increment its size
+    if(relationArrayResize(set_arr, set_arr->size + 1) == NULL)
+    {
+        reportError("Error! Couldn't resize an array of set_arr\n");
+        return false;
+    }
+
+    Relation_t *s = &set_arr->relation_arr[set_arr->size - 1];
+
+    // initialize a new set on the freed memory block
+    relationCtor(s, line_cnt + 1);
+
+    if(isPositionLine(line))
+        return parseSetPositions(line, delimiters, s, set_arr->relation_arr);
+
+    if(line[1] == '\0') // if set is empty
+    {
+        printSet(s, set_arr->relation_arr);
+        return true;
+    }
+
+    if(line_cnt == 0) // the universal set
+    {
+        if(!parseUniverse(line, delimiters, s))
+            return false;
+
+        printSet(s, s);
+        return true;
+    }
+
+    // if line declaring a set has a right format (S element1 element2 ...)
+    // there are a 'delimiters' set elements
+    uint32_t *ids = (uint32_t *) trackedMalloc((delimiters + 1) * sizeof(uint32_t), MEMORY_TEMPORARY);
+
+    if(ids == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    char *pos = line + 2;
+    int size = 0;
+
+    // get set elements one by one
+    for(char *token = nextToken(&pos); token != NULL; token = nextToken(&pos), size++)
+    {
+        if(!isValidSetElement(token))
+        {
+            reportError("Error! Invalid set element '%s'\n", token);
+            trackedFree(ids);
+            return false;
+        }
+
+        ids[size] = elementId(set_arr->relation_arr, token);
+
+        // check if a set element belongs to the universal set
+        if(ids[size] == (uint32_t) -1)
+        {
+            reportError("Error! Each set element must belong to the universal set\n");
+            trackedFree(ids);
+            return false;
+        }
+    }
+
+    qsort(ids, size, sizeof(uint32_t), compareId); // sort a set
+
+    // check if set contains a duplicate elements or not
+    if(containDuplicateId(ids, size))
+    {
+        reportError("Error! Each set element must be unique\n");
+        trackedFree(ids);
+        return false;
+    }
+
+    bool result = setFromIds(s, ids, size, set_arr->relation_arr->size);
+    trackedFree(ids);
+
+    if(result)
+        printSet(s, set_arr->relation_arr); // print set
+
+    return result;
+}
+
+// checks if set/relation is empty or not
+static bool isEmpty(const Relation_t *r)
+{
+    return r->size == 0;
+}
+
+// prints a size of the set ("card" command)
+static void printSetSize(Relation_t *r)
+{
+    printNumber(r->size);
+}
+
+// finds and returns a set/relation id in set/relation array by id using binary search algorithm
+// if it couldn't find a set/relation with specified id (or it was released) returns NULL
+static Relation_t *findById(Relation_arr_t *a, int id)
+{
+    int l = 0;
+    int h = a->size - 1;
+    int m;
+
+    while(l <= h)
+    {
+        m = (l + h) / 2;
+
+        int compare = id - a->relation_arr[m].id;
+
+        if(compare > 0)
+            l = m + 1;
+        else if(compare < 0)
+            h = m - 1;
+        else
+            return a->relation_arr[m].isReleased ? NULL : &a->relation_arr[m];
+    }
+
+    return NULL;
+}
+
+// checks if command over sets/relations has two mandatory parameters or not
+static bool isBinaryCommand(char *operation)
+{
+    for(int i = 3; i < 9; i++)
+        if(strcmp(operation, set_commands[i]) == 0)
+            return true;
+
+    // "select" and "compose"
+    if(strcmp(operation, relation_commands[13]) == 0 || strcmp(operation, relation_commands[14]) == 0)
+        return true;
+
+    // "image", "preimage", "reach" and "sample"
+    for(int i = 18; i <= 21; i++)
+        if(strcmp(operation, relation_commands[i]) == 0)
+            return true;
+
+    return false;
+}
+
+// checks if command over sets can have any number (at least two) of parameters ("union", "intersect" and "minus")
+static bool isNaryCommand(char *operation)
+{
+    for(int i = 3; i <= 5; i++)
+        if(strcmp(operation, set_commands[i]) == 0)
+            return true;
+
+    return false;
+}
+
+// checks if command over sets/relations has three mandatory parameters or not
+static bool isTernaryOperation(char *operation)
+{
+    for(int i = 7; i < 10; i++)
+        if(strcmp(operation, relation_commands[i]) == 0)
+            return true;
+
+    return false;
+}
+
+// checks if string contains a valid command parameter
+// i.e. it must contain an integer from the interval [1, 999] inclusively
+static bool checkCommandParam(char *str, int *id_number)
+{
+    if(str == NULL)
+        return false;
+
+    char *end_ptr;
+    *id_number = (int) strtol(str, &end_ptr, 10); // assigns an id to the *id_number
+
+    return *end_ptr == '\0' && *id_number >= 1 && *id_number <= 999;
+}
+
+// checks if command over sets/relations prints "true" or "false" as its output
+static bool printsTrueOrFalse(char *operation)
+{
+    if(strcmp(operation, set_commands[0]) == 0)
+        return true;
+
+    for(int i = 6; i <= 8; i++)
+    {
+        if(strcmp(operation, set_commands[i]) == 0)
+            return true;
+    }
+
+    for(int i = 0; i <= 4; i++)
+    {
+        if(strcmp(operation, relation_commands[i]) == 0)
+            return true;
+    }
+
+    for(int i = 7; i <= 9; i++)
+    {
+        if(strcmp(operation, relation_commands[i]) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+// parses an argument that represents a number of the line from the file
+// from which the program must continue reading the file
+// in the case when the output of the command over sets/relations is "false"
+static bool parseSkipArgument(char **token, char **pos, int *go_to_line)
+{
+    if(*token == NULL) // if there isn't an argument 'go_to_line'
+        return true;
+
+    if(!checkCommandParam(*token, go_to_line)) // write the argument to *go_to_line
+        return false;
+
+    *token = nextToken(pos); // rubbish value (it should be NULL)
+
+    return *token == NULL;
+}
+
+// parses a command over sets/relations
+static bool parseOperation(char *line, Command_t *c)
+{
+    char *pos = line + 2;
+    char *token = nextToken(&pos); // command name
+
+    if(token == NULL || !isCommand(token)) // if there is no command name or if token doesn't contain a valid command
+        return false;
+
+    strcpy(c->name, token); // copy command name
+
+    token = nextToken(&pos); // first command parameter
+
+    if(!checkCommandParam(token, &c->operands[0])) // write first command parameter to c->operands[0] if it is valid
+        return false;
+
+    token = nextToken(&pos); // second command parameter
+
+    bool isBinary = isBinaryCommand(c->name);
+    bool isTernary = isTernaryOperation(c->name);
+
+    if(!isBinary && !isTernary) // if command has only one mandatory parameter
+    {
+        if(printsTrueOrFalse(c->name))
+        {
+            // write go_to_line argument to c->operands[3] if it presents and it is valid
+            if(!parseSkipArgument(&token, &pos, &c->operands[3]))
+                return false;
+        }
+
+        return token == NULL; // there must not be any value after first parameter/go_to_line parameter
+    }
+    else // if command has two or three mandatory parameters
+    {
+        if(token == NULL) // if there are no parameters more
+            return false;
+    }
+
+    if(!checkCommandParam(token, &c->operands[1])) // write second command parameter to c->operands[1] if it is valid
+        return false;
+
+    if(strcmp(c->name, relation_commands[13]) == 0) // if command is "select"
+    {
+        // assign go_to_line value to c->operands[3] and assign 0 to c->operands[1] (make s 'swap')
+        c->operands[3] = c->operands[1];
+        c->operands[1] = 0;
+    }
+
+    token = nextToken(&pos); // third command parameter
+
+    if(isNaryCommand(c->name)) // write all parameters to c->nary_operands
+    {
+        c->nary_operands[0] = c->operands[0];
+        c->nary_operands[1] = c->operands[1];
+        c->nary_size = 2;
+
+        for(; token != NULL; token = nextToken(&pos))
+            if(c->nary_size == MAX_NARY_OPERANDS_NUMBER || !checkCommandParam(token, &c->nary_operands[c->nary_size++]))
+                return false;
+
+        return true;
+    }
+
+    if(isBinary) // if command has two mandatory parameters
+    {
+        if(printsTrueOrFalse(c->name))
+        {
+            // write go_to_line argument to c->operands[3] if it presents and it is valid
+            if(!parseSkipArgument(&token, &pos, &c->operands[3]))
+                return false;
+        }
+
+        return token == NULL; // there must not be any value after second parameter/go_to_line parameter
+    }
+
+    // if(isTernary)
+
+    if(!checkCommandParam(token, &c->operands[2])) // write third command parameter to c->operands[2] if it is valid
+        return false;
+
+    token = nextToken(&pos); // go_to_line or rubbish value
+
+    if(printsTrueOrFalse(c->name))
+    {
+        // write go_to_line argument to c->operands[3] if it presents and it is valid
+        if(!parseSkipArgument(&token, &pos, &c->operands[3]))
+            return false;
+    }
+
+    return token == NULL; // there must not be any value after third parameter/go_to_line parameter
+}
+
+// returns the first index 'i' from [lo, size) where ids[i] >= target ('size' if there is no such index)
+// uses exponential (galloping) search followed by binary search, so skipping 'd' ids costs only O(log d)
+static int gallop(const uint32_t *ids, int lo, int size, uint32_t target)
+{
+    int hi = lo;
+
+    for(int step = 1; hi < size && ids[hi] < target; step *= 2)
+    {
+        lo = hi + 1;
+        hi += step;
+    }
+
+    if(hi > size)
+        hi = size;
+
+    while(lo < hi) // binary search in [lo, hi]
+    {
+        int m = (lo + hi) / 2;
+
+        if(ids[m] < target)
+            lo = m + 1;
+        else
+            hi = m;
+    }
+
+    return lo;
+}
+
+// computes an intersection ('op' is SET_INTERSECT) or a difference ('op' is SET_MINUS) of two sorted arrays of ids
+// where the array 'small' is much smaller than the array 'large', only 'small' is walked element by element
+// returns a number of ids written to 'ids'
+static int gallopOperation(const uint32_t *small, int small_size, const uint32_t *large, int large_size, uint32_t *ids,
+                    Set_operation_t op)
+{
+    int size = 0;
+
+    for(int i = 0, j = 0; i < small_size; i++)
+    {
+        j = gallop(large, j, large_size, small[i]);
+
+        bool found = j < large_size && large[j] == small[i];
+
+        if(found == (op == SET_INTERSECT))
+            ids[size++] = small[i];
+    }
+
+    return size;
+}
+
+// computes an intersection of two sorted arrays of ids of comparable sizes
+// the merge is branchless (both indexes move by comparison results), so it doesn't suffer from branch mispredictions
+// returns a number of ids written to 'ids'
+static int mergeIntersection(const uint32_t *a, int a_size, const uint32_t *b, int b_size, uint32_t *ids)
+{
+    int size = 0;
+
+    for(int i = 0, j = 0; i < a_size && j < b_size; )
+    {
+        uint32_t x = a[i];
+        uint32_t y = b[j];
+
+        ids[size] = x;
+        size += x == y;
+        i += x <= y;
+        j += y <= x;
+    }
+
+    return size;
+}
+
+// computes an operation 'op' over two sets stored in arrays (merges two sorted arrays of ids)
+// the result will be stored in the set 'new'
+static bool arrayOperation(const Relation_t *a, const Relation_t *b, Relation_t *new, Set_operation_t op, int universe_size)
+{
+    uint32_t *ids = (uint32_t *) trackedMalloc((a->size + b->size + 1) * sizeof(uint32_t), MEMORY_TEMPORARY);
+    int size = 0;
+
+    if(ids == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    if(op == SET_INTERSECT && a->size * GALLOP_RATIO < b->size)
+        size = gallopOperation(a->ids, a->size, b->ids, b->size, ids, op);
+    else if(op == SET_INTERSECT && b->size * GALLOP_RATIO < a->size)
+        size = gallopOperation(b->ids, b->size, a->ids, a->size, ids, op);
+    else if(op == SET_INTERSECT)
+        size = mergeIntersection(a->ids, a->size, b->ids, b->size, ids);
+    else if(op == SET_MINUS && a->size * GALLOP_RATIO < b->size)
+        size = gallopOperation(a->ids, a->size, b->ids, b->size, ids, op);
+    else
+    {
+        int i = 0, j = 0;
+
+        while(i < a->size && j < b->size) // loop until at least one set is fully processed
+        {
+            if(a->ids[i] < b->ids[j]) // element is only in the set 'a'
+                ids[size++] = a->ids[i++];
+            else if(a->ids[i] > b->ids[j]) // element is only in the set 'b'
+            {
+                if(op == SET_UNION)
+                    ids[size++] = b->ids[j];
+
+                j++;
+            }
+            else // if elements are the same
+            {
+                if(op == SET_UNION)
+                    ids[size++] = a->ids[i];
+
+                i++;
+                j++;
+            }
+        }
+
+        // rest of the elements from the set 'a' or the set 'b'
+        for(; i < a->size; i++)
+            ids[size++] = a->ids[i];
+
+        for(; j < b->size && op == SET_UNION; j++)
+            ids[size++] = b->ids[j];
+    }
+
+    bool result = setFromIds(new, ids, size, universe_size);
+
+    trackedFree(ids);
+    return result;
+}
+
+// computes an operation 'op' over sets 'a' and 'b' with any kinds of containers
+// the result will be stored in the set 'new'
+static bool setOperation(const Relation_t *a, const Relation_t *b, Relation_t *new, Set_operation_t op, int universe_size)
+{
+    // a union with an empty set or a difference without any element is equal to the set 'a', so it shares it
+    if(op != SET_INTERSECT && b->size == 0)
+    {
+        relationShare(new, a);
+        return true;
+    }
+
+    if(op == SET_UNION && a->size == 0)
+    {
+        relationShare(new, b);
+        return true;
+    }
+
+    if(a->kind == CONTAINER_ARRAY && b->kind == CONTAINER_ARRAY)
+        return arrayOperation(a, b, new, op, universe_size);
+
+    // other kinds of containers are turned into bitmaps and combined word by word
+    int words = bitsetWords(universe_size);
+    uint64_t *bits_a = (uint64_t *) trackedMalloc((words + 1) * sizeof(uint64_t), MEMORY_TEMPORARY);
+    uint64_t *bits_b = (uint64_t *) trackedMalloc((words + 1) * sizeof(uint64_t), MEMORY_TEMPORARY);
+
+    if(bits_a == NULL || bits_b == NULL)
+    {
+        trackedFree(bits_a);
+        trackedFree(bits_b);
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    setToBitset(a, bits_a, words);
+    setToBitset(b, bits_b, words);
+    bitsetCombine(bits_a, bits_b, words, op);
+
+    bool result = setFromBitset(new, bits_a, universe_size);
+
+    trackedFree(bits_a);
+    trackedFree(bits_b);
+    return result;
+}
+
+// computes an operation 'op' over 'count' sets in one pass (a \ b \ c ... in case of SET_MINUS)
+// the result will be stored in the set 'new'
+// more than two sets are combined word by word into one bitmap without any intermediate sets
+static bool setsOperation(const Relation_t **sets, int count, Relation_t *new, Set_operation_t op, int universe_size)
+{
+    if(count == 2)
+        return setOperation(sets[0], sets[1], new, op, universe_size);
+
+    // an intersection starts with the smallest set, so it is empty as soon as possible
+    if(op == SET_INTERSECT)
+    {
+        for(int i = 1; i < count; i++)
+        {
+            if(sets[i]->size < sets[0]->size)
+            {
+                const Relation_t *tmp = sets[0];
+                sets[0] = sets[i];
+                sets[i] = tmp;
+            }
+        }
+    }
+
+    int words = bitsetWords(universe_size);
+    uint64_t *acc = (uint64_t *) trackedMalloc((words + 1) * sizeof(uint64_t), MEMORY_TEMPORARY); // accumulated result
+    uint64_t *bits = (uint64_t *) trackedMalloc((words + 1) * sizeof(uint64_t), MEMORY_TEMPORARY); // current operand
+
+    if(acc == NULL || bits == NULL)
+    {
+        trackedFree(acc);
+        trackedFree(bits);
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    setToBitset(sets[0], acc, words);
+
+    // stop an intersection/difference when the result is empty
+    for(int i = 1, isNonEmpty = sets[0]->size != 0; i < count && (op == SET_UNION || isNonEmpty); i++)
+    {
+        setToBitset(sets[i], bits, words);
+        isNonEmpty = bitsetCombine(acc, bits, words, op);
+    }
+
+    bool result = setFromBitset(new, acc, universe_size);
+
+    trackedFree(acc);
+    trackedFree(bits);
+    return result;
+}
+
+// computes a complement of the set 'a' (U \ a)
+// the complement will be stored in the set 'new', it is computed by inverting the bitmap of the set 'a'
+static bool complementSet(const Relation_t *a, Relation_t *new, const Relation_t *universal_set)
+{
+    int words = bitsetWords(universal_set->size);
+    uint64_t *bits = (uint64_t *) trackedMalloc((words + 1) * sizeof(uint64_t), MEMORY_TEMPORARY);
+
+    if(bits == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    setToBitset(a, bits, words);
+
+    for(int w = 0; w < words; w++)
+        bits[w] = ~bits[w];
+
+    if(words != 0) // bits after the last universe element don't belong to the complement
+        bits[words - 1] &= bitsetLastMask(universal_set->size);
+
+    bool result = setFromBitset(new, bits, universal_set->size);
+
+    trackedFree(bits);
+    return result;
+}
+
+// checks if set 'a' and set 'b' are equal
+static bool isEqual(const Relation_t *a, const Relation_t *b)
+{
+    // equal sets must have the same sizes, the same smallest and largest elements and the same fingerprints
+    if(a->size != b->size || a->min_id != b->min_id || a->max_id != b->max_id || a->fingerprint != b->fingerprint)
+        return false;
+
+    // equal sets have the same kind of container with the same content, so compare whole blocks of memory
+    if(a->kind != b->kind)
+        return false;
+
+    if(a->kind == CONTAINER_ARRAY)
+        return a->size == 0 || memcmp(a->ids, b->ids, a->size * sizeof(uint32_t)) == 0;
+
+    if(a->kind == CONTAINER_RUN)
+        return a->runs == b->runs && memcmp(a->ids, b->ids, 2 * a->runs * sizeof(uint32_t)) == 0;
+
+    // only words between the smallest and the largest element can differ
+    int first = a->min_id / WORD_BITS;
+    int words = a->max_id / WORD_BITS - first + 1;
+
+    return memcmp(&a->bits[first], &b->bits[first], words * sizeof(uint64_t)) == 0;
+}
+
+// checks if cheap facts about sets (sizes, smallest and largest ids, fingerprints) allow set 'a' to be a subset of set 'b'
+// returns false only if set 'a' surely isn't a subset of set 'b'
+static bool canBeSubset(const Relation_t *a, const Relation_t *b)
+{
+    // if size of set 'a' is greater than a size of set 'b' it can't be a subset of set 'b'
+    if(a->size > b->size)
+        return false;
+
+    if(a->size == 0)
+        return true;
+
+    // elements of set 'a' must lie between the smallest and the largest element of set 'b'
+    if(a->min_id < b->min_id || a->max_id > b->max_id)
+        return false;
+
+    // every element of set 'a' sets a bit that must be set by some element of set 'b' too
+    return (a->fingerprint & ~b->fingerprint) == 0;
+}
+
+// checks if every run of set 'a' lies inside of some run of set 'b' (both sets are kept in runs)
+static bool isRunSubset(const Relation_t *a, const Relation_t *b)
+{
+    for(int i = 0, j = 0; i < a->runs; i++)
+    {
+        // skip runs of set 'b' that end before the run of set 'a' starts
+        while(j < b->runs && b->ids[2 * j + 1] < a->ids[2 * i])
+            j++;
+
+        if(j == b->runs || b->ids[2 * j] > a->ids[2 * i] || b->ids[2 * j + 1] < a->ids[2 * i + 1])
+            return false;
+    }
+
+    return true;
+}
+
+// checks if set 'a' is a subset of set 'b'
+// cheap facts are checked first, then the cheapest algorithm for the containers of both sets is used
+static bool isSubset(const Relation_t *a, const Relation_t *b)
+{
+    if(!canBeSubset(a, b))
+        return false;
+
+    if(a->size == 0)
+        return true;
+
+    // a subset of the same size is the same set
+    if(a->size == b->size)
+        return isEqual(a, b);
+
+    if(a->kind == CONTAINER_BITMAP && b->kind == CONTAINER_BITMAP)
+    {
+        // compare whole words between the smallest and the largest element of set 'a'
+        return bitsetSubset(a->bits, b->bits, a->min_id / WORD_BITS, a->max_id / WORD_BITS);
+    }
+
+    if(a->kind == CONTAINER_RUN && b->kind == CONTAINER_RUN)
+        return isRunSubset(a, b);
+
+    if(a->kind == CONTAINER_ARRAY && b->kind == CONTAINER_ARRAY)
+    {
+        // every element of the set 'a' is searched in the rest of the set 'b' (by galloping if 'a' is much smaller)
+        for(int i = 0, j = 0; i < a->size; i++, j++)
+        {
+            if(a->size * GALLOP_RATIO < b->size)
+                j = gallop(b->ids, j, b->size, a->ids[i]);
+            else
+                while(j < b->size && b->ids[j] < a->ids[i])
+                    j++;
+
+            if(j == b->size || b->ids[j] != a->ids[i]) // if element from set 'a' doesn't belong to the set 'b'
+                return false;
+        }
+
+        return true;
+    }
+
+    // elements of set 'a' are probed in set 'b' (a constant time for a bitmap, a binary search otherwise)
+    Set_iterator_t it;
+    setIteratorCtor(&it, a);
+
+    while(setIteratorNext(&it))
+        if(!setContains(b, it.id)) // if element from set 'a' doesn't belong to the set 'b'
+            return false;
+
+    return true;
+}
+
+// checks if set 'a' is a proper subset of set 'b'
+static bool isProperSubset(const Relation_t *a, const Relation_t *b)
+{
+    // set 'a' is a proper subset of set 'b' if it is a subset of set 'b' and it is smaller than set 'b'
+    return a->size < b->size && isSubset(a, b);
+}
+
+// returns number of relation pairs that have the same first and second element (i.e. pair is (x, y) where x == y)
+static int reflexivePairs(const Relation_t *r, const Relation_t *universal_set)
+{
+    int count = 0;
+
+    for(int x = 0; x < universal_set->size; x++)
+        if(hasPair(r, x, x)) // if pair is (x, y) and x == y
+            count++;
+
+    return count;
+}
+
+// checks if a relation is a symmetric
+static bool isSymmetric(const Relation_t *r, const Relation_t *universal_set)
+{
+    for(int x = 0; x < universal_set->size; x++)
+    {
+        // if xRy => than yRx
+        for(int i = r->fwd_start[x]; i < r->fwd_start[x + 1]; i++)
+            if(!hasPair(r, r->fwd_adj[i], x))
+                return false;
+    }
+
+    return true;
+}
+
+// checks if a relation is a reflexive
+static bool isReflexive(const Relation_t *r, const Relation_t *universal_set)
+{
+    // if a relation is reflexive is must contain all pairs xRx where x belongs to the universal set
+    // (an empty relation will be reflexive only if a universal set is empty)
+    return reflexivePairs(r, universal_set) == universal_set->size;
+}
+
+// checks if string contains a command over sets
+static bool isSetCommand(char *str)
+{
+    for(int i = 0; i < 9; i++)
+        if(strcmp(str, set_commands[i]) == 0)
+            return true;
+
+    return false;
+}
+
+// initializes a set 'new' from elements that have a non-empty row in the CSR index with row offsets 'start'
+static bool setFromRows(Relation_t *new, const int *start, int universe_size)
+{
+    uint32_t *ids = (uint32_t *) trackedMalloc((universe_size + 1) * sizeof(uint32_t), MEMORY_TEMPORARY);
+    int size = 0;
+
+    if(ids == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    // rows are in order of ids, so the set is sorted
+    for(int x = 0; x < universe_size; x++)
+        if(start[x + 1] != start[x])
+            ids[size++] = x;
+
+    bool result = setFromIds(new, ids, size, universe_size);
+
+    trackedFree(ids);
+    return result;
+}
+
+// prints a domain of the relation
+// the domain of the relation will be stored in the set 'new'
+static bool printDomain(const Relation_t *r, Relation_t *new, const Relation_t *universal_set)
+{
+    // the domain is made of elements (x) that have at least one successor in the forward index
+    if(!setFromRows(new, r->fwd_start, universal_set->size))
+        return false;
+
+    printSet(new, universal_set); // print set
+    return true;
+}
+
+// gets a codomain of the relation
+// the codomain of the relation will be stored in the set 'new'
+static bool printCodomain(const Relation_t *r, Relation_t *new, bool isPrint, const Relation_t *universal_set)
+{
+    // the codomain is made of elements (y) that have at least one predecessor in the reverse index
+    if(!setFromRows(new, r->rev_start, universal_set->size))
+        return false;
+
+    // if it is needed to print a 'new' set
+    if(isPrint)
+        printSet(new, universal_set);
+
+    return true;
+}
+
+// checks if a relation is a function
+static bool isFunction(const Relation_t *r, const Relation_t *universal_set)
+{
+    // checks if every first element (x) from the relation is unique
+    // i.e. every x in every relation pair is in the relation with another y
+    for(int x = 0; x < universal_set->size; x++)
+        if(outDegree(r, x) > 1)
+            return false;
+
+    return true;
+}
+
+
+// checks if a relation 'r' is an injective function
+// relation 'r' domain is a set 'a', its codomain is a set 'b'
+static bool isInjective(const Relation_t *r, const Relation_t *a, const Relation_t *b, const Relation_t *universal_set)
+{
+    if(isEmpty(r)) // if a relation 'r' is empty it can be injective only if both its domain and codomain are empty
+        return isEmpty(a) && isEmpty(b);
+
+    if(r->size != a->size) // relation 'r' must have the same size as a relation 'a' (its domain)
+        return false;
+
+    // check if every y from every relation pair (x, y) is unique
+    // i.e. every y in every relation pair is in the relation with another x
+    // check if y from every relation pair (x, y) belongs to the set 'b' (relation codomain)
+    // check if x from every relation pair (x, y) belongs to the set 'a' (relation domain)
+    for(int y = 0; y < universal_set->size; y++)
+    {
+        if(inDegree(r, y) == 0)
+            continue;
+
+        if(inDegree(r, y) > 1 || !setContains(b, y) || !setContains(a, r->rev_adj[r->rev_start[y]]))
+            return false;
+    }
+
+    return true;
+}
+
+// checks if a relation 'r' is a surjective function
+// relation 'r' domain is a set 'a', its codomain is a set 'b'
+static bool isSurjective(const Relation_t *r, const Relation_t *a, const Relation_t *b, const Relation_t *universal_set)
+{
+    if(isEmpty(r)) // if a relation 'r' is empty it can be surjective only if both its domain and codomain are empty
+        return isEmpty(a) && isEmpty(b);
+
+    // relation 'r' size must not be less than size of its domain (set 'a') and its codomain (set 'b')
+    if(r->size < a->size || r->size < b->size)
+        return false;
+
+    Relation_t rel_codomain; // set that will keep the codomain of the relation 'r'
+    relationCtor(&rel_codomain, -1); // initialize it
+
+    if(!printCodomain(r, &rel_codomain, false, universal_set)) // if error occurred
+    {
+        relationDtor(&rel_codomain); // free memory
+        return false;
+    }
+
+    if(!isEqual(&rel_codomain, b)) // compare 'codomains' (they must be the same)
+    {
+        relationDtor(&rel_codomain); // free memory
+        return false;
+    }
+
+    relationDtor(&rel_codomain); // free memory
+
+    // check if x from every relation pair (x, y) belongs to the set 'a' (relation domain)
+    for(int x = 0; x < universal_set->size; x++)
+        if(outDegree(r, x) != 0 && !setContains(a, x))
+            return false;
+
+    return true;
+}
+
+// checks if a relation 'r' is a bijective function
+// relation 'r' domain is a set 'a', its codomain is a set 'b'
+static bool isBijective(const Relation_t *r, const Relation_t *a, const Relation_t *b, const Relation_t *universal_set)
+{
+    // the relation is bijective if it is both injective and surjective
+    return isInjective(r, a, b, universal_set) && isSurjective(r, a, b, universal_set);
+}
+
+// checks if a relation 'r' is antisymmetric
+static bool isAntisymmetric(const Relation_t *r, const Relation_t *universal_set)
+{
+    // check if for every single relation pair in 'r' works: if xRy and x != y => than y notR x
+    for(int x = 0; x < universal_set->size; x++)
+        for(int i = r->fwd_start[x]; i < r->fwd_start[x + 1]; i++)
+            if(r->fwd_adj[i] != x && hasPair(r, r->fwd_adj[i], x))
+                return false;
+
+    return true;
+}
+
+// initializes relation 'new' from 'size' relation pairs given by ids of their elements (xs[i], ys[i])
+// and builds its index
+static bool relationFromIds(Relation_t *new, const int *xs, const int *ys, int size, const Relation_t *universal_set)
+{
+    new->xs = (int *) trackedMalloc((size + 1) * sizeof(int), MEMORY_RELATION);
+    new->ys = (int *) trackedMalloc((size + 1) * sizeof(int), MEMORY_RELATION);
+
+    if(new->xs == NULL || new->ys == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a relation\n");
+        return false;
+    }
+
+    if(size != 0)
+    {
+        memcpy(new->xs, xs, size * sizeof(int));
+        memcpy(new->ys, ys, size * sizeof(int));
+    }
+
+    new->size = size;
+    return relationIndexCtor(new, universal_set);
+}
+
+// returns an adjacency matrix of the relation 'r' with one bitset row of 'words' words for every universe element
+// bit y of the row x is set if xRy (NULL if there is no memory)
+static uint64_t *relationRows(const Relation_t *r, int n, int words)
+{
+    uint64_t *rows = (uint64_t *) trackedCalloc((long) n * words + 1, sizeof(uint64_t), MEMORY_TEMPORARY);
+
+    if(rows == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for an adjacency matrix\n");
+        return NULL;
+    }
+
+    for(int x = 0; x < n; x++)
+        for(int i = r->fwd_start[x]; i < r->fwd_start[x + 1]; i++)
+            bitsetSet(&rows[x * words], r->fwd_adj[i]);
+
+    return rows;
+}
+
+// checks if a relation 'r' is transitive
+static bool isTransitive(const Relation_t *r, const Relation_t *universal_set)
+{
+    int n = universal_set->size;
+    int words = bitsetWords(n);
+    uint64_t *rows = relationRows(r, n, words);
+
+    if(rows == NULL)
+        return false;
+
+    bool result = true;
+
+    // if aRb and bRc => than aRc, i.e. the row of every b such that aRb must be a subset of the row of a
+    // rows are compared a whole word at a time
+    for(int a = 0; a < n && result; a++)
+        for(int i = r->fwd_start[a]; i < r->fwd_start[a + 1] && result; i++)
+            result = bitsetSubset(&rows[r->fwd_adj[i] * words], &rows[a * words], 0, words - 1);
+
+    trackedFree(rows);
+    return result;
+}
+
+// remembers if the property 'property' holds for the relation 'r'
+static void setProperty(Relation_t *r, Property_t property, bool holds)
+{
+    r->known_properties |= 1 << property;
+
+    if(holds)
+        r->properties |= 1 << property;
+    else
+        r->properties &= ~(1 << property);
+}
+
+// computes a reflexive closure of the relation 'r' (fast engine)
+// the reflexive closure of the relation 'r' will be stored in the relation 'new'
+// the pair (x, x) is put into the sorted row of every element x, so the closure is sorted and made in O(|U| + |R|)
+static bool reflexiveClosure(const Relation_t *r, Relation_t *new, const Relation_t *universal_set)
+{
+    int n = universal_set->size;
+
+    if(isReflexive(r, universal_set)) // the closure is the relation 'r' itself
+    {
+        relationShare(new, r);
+        return true;
+    }
+
+    int *xs = (int *) trackedMalloc((r->size + n + 1) * sizeof(int), MEMORY_TEMPORARY);
+    int *ys = (int *) trackedMalloc((r->size + n + 1) * sizeof(int), MEMORY_TEMPORARY);
+
+    if(xs == NULL || ys == NULL)
+    {
+        trackedFree(xs);
+        trackedFree(ys);
+        reportError("Error! Couldn't allocate memory for a reflexive closure\n");
+        return false;
+    }
+
+    int size = 0;
+
+    for(int x = 0; x < n; x++)
+    {
+        int i = r->fwd_start[x];
+        int end = r->fwd_start[x + 1];
+
+        // successors smaller than x, then (x, x), then the rest of the row (without (x, x) if it is already there)
+        for(; i < end && r->fwd_adj[i] < x; i++)
+        {
+            xs[size] = x;
+            ys[size++] = r->fwd_adj[i];
+        }
+
+        if(i < end && r->fwd_adj[i] == x)
+            i++;
+
+        xs[size] = x;
+        ys[size++] = x;
+
+        for(; i < end; i++)
+        {
+            xs[size] = x;
+            ys[size++] = r->fwd_adj[i];
+        }
+    }
+
+    bool result = relationFromIds(new, xs, ys, size, universal_set);
+
+    trackedFree(xs);
+    trackedFree(ys);
+
+    return result;
+}
+
+// computes a symmetric closure of the relation 'r' (fast engine)
+// the symmetric closure of the relation 'r' will be stored in the relation 'new'
+// the row of every element x is a merge of its successors and its predecessors (both rows are sorted), so the closure
+// is sorted and made in O(|U| + |R|)
+static bool symmetricClosure(const Relation_t *r, Relation_t *new, const Relation_t *universal_set)
+{
+    int n = universal_set->size;
+
+    if(isSymmetric(r, universal_set)) // the closure is the relation 'r' itself
+    {
+        relationShare(new, r);
+        return true;
+    }
+
+    int *xs = (int *) trackedMalloc((2 * r->size + 1) * sizeof(int), MEMORY_TEMPORARY);
+    int *ys = (int *) trackedMalloc((2 * r->size + 1) * sizeof(int), MEMORY_TEMPORARY);
+
+    if(xs == NULL || ys == NULL)
+    {
+        trackedFree(xs);
+        trackedFree(ys);
+        reportError("Error! Couldn't allocate memory for a symmetric closure\n");
+        return false;
+    }
+
+    int size = 0;
+
+    for(int x = 0; x < n; x++)
+    {
+        int i = r->fwd_start[x];
+        int j = r->rev_start[x];
+
+        // merge (x, y) for xRy and (x, y) for yRx, a pair that is in both rows is added only once
+        while(i < r->fwd_start[x + 1] || j < r->rev_start[x + 1])
+        {
+            int y;
+
+            if(j == r->rev_start[x + 1] || (i < r->fwd_start[x + 1] && r->fwd_adj[i] < r->rev_adj[j]))
+                y = r->fwd_adj[i++];
+            else if(i == r->fwd_start[x + 1] || r->rev_adj[j] < r->fwd_adj[i])
+                y = r->rev_adj[j++];
+            else
+            {
+                y = r->fwd_adj[i++];
+                j++;
+            }
+
+            xs[size] = x;
+            ys[size++] = y;
+        }
+    }
+
+    bool result = relationFromIds(new, xs, ys, size, universal_set);
+
+    trackedFree(xs);
+    trackedFree(ys);
+
+    return result;
+}
+
+// computes a transitive closure of the relation 'r' (fast engine)
+// the transitive closure of the relation 'r' will be stored in the relation 'new'
+// it is Warshall's algorithm over bitset rows of the adjacency matrix: for every pivot k, every row x with xRk gets
+// the whole row of k at once, so one step adds up to WORD_BITS pairs
+static bool transitiveClosure(const Relation_t *r, Relation_t *new, const Relation_t *universal_set)
+{
+    int n = universal_set->size;
+    int words = bitsetWords(n);
+    uint64_t *rows = relationRows(r, n, words);
+
+    if(rows == NULL)
+        return false;
+
+    for(int k = 0; k < n; k++)
+    {
+        const uint64_t *pivot = &rows[k * words];
+
+        // a pivot without successors or predecessors can't add any pair
+        if(inDegree(r, k) == 0 || outDegree(r, k) == 0)
+            continue;
+
+        for(int x = 0; x < n; x++)
+            if(bitsetTest(&rows[x * words], k))
+                bitsetCombine(&rows[x * words], pivot, words, SET_UNION);
+    }
+
+    int size = bitsetCount(rows, n * words);
+
+    if(size == r->size) // no pair was added, the closure is the relation 'r' itself
+    {
+        trackedFree(rows);
+        relationShare(new, r);
+        return true;
+    }
+
+    int *xs = (int *) trackedMalloc((size + 1) * sizeof(int), MEMORY_TEMPORARY);
+    int *ys = (int *) trackedMalloc((size + 1) * sizeof(int), MEMORY_TEMPORARY);
+
+    if(xs == NULL || ys == NULL)
+    {
+        trackedFree(xs);
+        trackedFree(ys);
+        trackedFree(rows);
+        reportError("Error! Couldn't allocate memory for a transitive closure\n");
+        return false;
+    }
+
+    for(int x = 0, i = 0; x < n; x++)
+    {
+        for(int w = 0; w < words; w++)
+        {
+            for(uint64_t word = rows[x * words + w]; word != 0; word &= word - 1) // clear the lowest bit set
+            {
+                xs[i] = x;
+                ys[i++] = w * WORD_BITS + lowestBit(word);
+            }
+        }
+    }
+
+    bool result = relationFromIds(new, xs, ys, size, universal_set);
+
+    trackedFree(xs);
+    trackedFree(ys);
+    trackedFree(rows);
+
+    return result;
+}
+
+// checks if 'size' relation pairs (xs[i], ys[i]) contain the pair (x, y), it goes through all pairs
+static bool containsPair(const int *xs, const int *ys, int size, int x, int y)
+{
+    for(int i = 0; i < size; i++)
+        if(xs[i] == x && ys[i] == y)
+            return true;
+
+    return false;
+}
+
+// the reference engine keeps the original algorithms of setcal: sets are sorted lists of elements merged by two at a
+// time and relations are lists of pairs searched from the start, only names of elements are replaced by their ids
+
+// checks if a relation 'r' is reflexive (reference engine)
+static bool referenceIsReflexive(const Relation_t *r, const Relation_t *universal_set)
+{
+    if(isEmpty(r)) // if a relation is empty it will be reflexive only if a universal set is empty
+        return isEmpty(universal_set);
+
+    int count = 0; // number of relation pairs (x, x)
+
+    for(int i = 0; i < r->size; i++)
+        if(r->xs[i] == r->ys[i])
+            count++;
+
+    // if a relation is reflexive is must contain all pairs xRx where x belongs to the universal set
+    return count == universal_set->size;
+}
+
+// checks if a relation 'r' is symmetric (reference engine)
+static bool referenceIsSymmetric(const Relation_t *r, const Relation_t *universal_set)
+{
+    (void) universal_set; // the same parameters as the fast engine
+
+    if(isEmpty(r))
+        return true;
+
+    // if xRy => than yRx
+    for(int i = 0; i < r->size; i++)
+        if(!containsPair(r->xs, r->ys, r->size, r->ys[i], r->xs[i]))
+            return false;
+
+    return true;
+}
+
+// checks if a relation 'r' is antisymmetric (reference engine)
+static bool referenceIsAntisymmetric(const Relation_t *r, const Relation_t *universal_set)
+{
+    (void) universal_set; // the same parameters as the fast engine
+
+    if(isEmpty(r))
+        return true;
+
+    // if xRy and x != y => than y notR x
+    for(int i = 0; i < r->size; i++)
+        if(containsPair(r->xs, r->ys, r->size, r->ys[i], r->xs[i]) && r->xs[i] != r->ys[i])
+            return false;
+
+    return true;
+}
+
+// checks if a relation 'r' is transitive (reference engine)
+static bool referenceIsTransitive(const Relation_t *r, const Relation_t *universal_set)
+{
+    (void) universal_set; // the same parameters as the fast engine
+
+    // if aRb and bRc => than aRc
+    for(int i = 0; i < r->size; i++)
+        for(int j = 0; j < r->size; j++)
+            if(r->ys[i] == r->xs[j] && !containsPair(r->xs, r->ys, r->size, r->xs[i], r->ys[j]))
+                return false;
+
+    return true;
+}
+
+// checks if a relation 'r' is a function (reference engine)
+// first elements of pairs are sorted by a bubble sort, then every first element must differ from the next one
+static bool referenceIsFunction(const Relation_t *r, const Relation_t *universal_set)
+{
+    (void) universal_set; // the same parameters as the fast engine
+
+    if(isEmpty(r))
+        return true;
+
+    int *xs = (int *) trackedMalloc(r->size * sizeof(int), MEMORY_TEMPORARY);
+
+    if(xs == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a relation\n");
+        return false;
+    }
+
+    memcpy(xs, r->xs, r->size * sizeof(int));
+
+    for(int i = 0; i < r->size - 1; i++)
+    {
+        for(int j = 0; j < r->size - 1 - i; j++)
+        {
+            if(xs[j] > xs[j + 1])
+            {
+                int tmp = xs[j];
+                xs[j] = xs[j + 1];
+                xs[j + 1] = tmp;
+            }
+        }
+    }
+
+    bool isUnique = true; // every x is in the relation with only one y
+
+    for(int i = 0; i < r->size - 1 && isUnique; i++)
+        isUnique = xs[i] != xs[i + 1];
+
+    trackedFree(xs);
+    return isUnique;
+}
+
+// allocates arrays 'xs' and 'ys' for 'capacity' relation pairs and copies pairs of the relation 'r' to them
+// (the start of every closure of the reference engine), returns false if there is no memory
+static bool referenceCopyPairs(const Relation_t *r, int capacity, int **xs, int **ys)
+{
+    *xs = (int *) trackedMalloc((capacity + 1) * sizeof(int), MEMORY_TEMPORARY);
+    *ys = (int *) trackedMalloc((capacity + 1) * sizeof(int), MEMORY_TEMPORARY);
+
+    if(*xs == NULL || *ys == NULL)
+    {
+        trackedFree(*xs);
+        trackedFree(*ys);
+        reportError("Error! Couldn't allocate memory for a closure\n");
+        return false;
+    }
+
+    memcpy(*xs, r->xs, r->size * sizeof(int));
+    memcpy(*ys, r->ys, r->size * sizeof(int));
+    return true;
+}
+
+// computes a reflexive closure of the relation 'r' (reference engine)
+// the closure will be stored in the relation 'new'
+static bool referenceReflexiveClosure(const Relation_t *r, Relation_t *new, const Relation_t *universal_set)
+{
+    int *xs, *ys;
+    int size = r->size;
+
+    if(!referenceCopyPairs(r, r->size + universal_set->size, &xs, &ys)) // copy 'r' to 'new'
+        return false;
+
+    // for every single element (x) from the universal set check if there is a relation pair (x, x) in the relation
+    // if not => add it to the 'new' relation
+    for(int x = 0; x < universal_set->size; x++)
+    {
+        if(!containsPair(r->xs, r->ys, r->size, x, x))
+        {
+            xs[size] = x;
+            ys[size++] = x;
+        }
+    }
+
+    bool result = relationFromIds(new, xs, ys, size, universal_set);
+
+    trackedFree(xs);
+    trackedFree(ys);
+    return result;
+}
+
+// computes a symmetric closure of the relation 'r' (reference engine)
+// the closure will be stored in the relation 'new'
+static bool referenceSymmetricClosure(const Relation_t *r, Relation_t *new, const Relation_t *universal_set)
+{
+    int *xs, *ys;
+    int size = r->size;
+
+    if(!referenceCopyPairs(r, 2 * r->size, &xs, &ys)) // copy 'r' to 'new'
+        return false;
+
+    // for every single relation pair (x, y) check if there is a relation pair (y, x) in the relation 'new'
+    // if not => add it to the 'new' relation
+    for(int i = 0; i < r->size; i++)
+    {
+        if(!containsPair(xs, ys, size, ys[i], xs[i]))
+        {
+            xs[size] = ys[i];
+            ys[size++] = xs[i];
+        }
+    }
+
+    bool result = relationFromIds(new, xs, ys, size, universal_set);
+
+    trackedFree(xs);
+    trackedFree(ys);
+    return result;
+}
+
+// computes a transitive closure of the relation 'r' (reference engine)
+// the closure will be stored in the relation 'new'
+static bool referenceTransitiveClosure(const Relation_t *r, Relation_t *new, const Relation_t *universal_set)
+{
+    int *xs, *ys;
+    int size = r->size;
+
+    // the closure has at most all pairs of universe elements
+    if(!referenceCopyPairs(r, universal_set->size * universal_set->size, &xs, &ys)) // copy 'r' to 'new'
+        return false;
+
+    while(1)
+    {
+        int append_number = 0; // number of added relation pairs to the 'new' relation per one iteration
+
+        int old_size = size;
+
+        // if there is a relation pair (a, b) in 'r' and (b, c) => there must be a relation pair (a, c)
+        for(int i = 0; i < old_size; i++)
+        {
+            for(int j = 0; j < old_size; j++)
+            {
+                if(ys[i] == xs[j] && !containsPair(xs, ys, size, xs[i], ys[j]))
+                {
+                    xs[size] = xs[i];
+                    ys[size++] = ys[j];
+                    append_number++;
+                }
+            }
+        }
+
+        // loop until no changes were done
+        if(append_number != 0)
+            continue;
+
+        break;
+    }
+
+    bool result = relationFromIds(new, xs, ys, size, universal_set);
+
+    trackedFree(xs);
+    trackedFree(ys);
+    return result;
+}
+
+// returns ids of elements of the set 's' in a new sorted array (a list of set elements of the reference engine),
+// NULL if there is no memory
+static uint32_t *referenceIds(const Relation_t *s)
+{
+    uint32_t *ids = (uint32_t *) trackedMalloc((s->size + 1) * sizeof(uint32_t), MEMORY_TEMPORARY);
+
+    if(ids == NULL)
+        return NULL;
+
+    Set_iterator_t it;
+    setIteratorCtor(&it, s);
+
+    for(int i = 0; setIteratorNext(&it); i++)
+        ids[i] = it.id;
+
+    return ids;
+}
+
+// writes a union of sorted sets 'a' and 'b' to 'ids' (reference engine), returns its size
+static int referenceUnion(const uint32_t *a, int a_size, const uint32_t *b, int b_size, uint32_t *ids)
+{
+    int size = 0;
+
+    for(int i = 0, j = 0; i < a_size || j < b_size; ) // loop until all elements from both sets are processed
+    {
+        int compare = 0;
+
+        if(i != a_size && j != b_size) // if not all elements from both sets are processed
+            compare = a[i] < b[j] ? -1 : a[i] > b[j];
+
+        // if all elements from set 'a' were processed or 'b[j]' is not in set 'a'
+        if(i == a_size || compare > 0)
+            ids[size++] = b[j++];
+        // if all elements from set 'b' were processed or 'a[i]' is not in set 'b'
+        else if(j == b_size || compare < 0)
+            ids[size++] = a[i++];
+        else // if compare == 0 => elements are the same
+        {
+            ids[size++] = a[i++];
+            j++;
+        }
+    }
+
+    return size;
+}
+
+// writes an intersection of sorted sets 'a' and 'b' to 'ids' (reference engine), returns its size
+static int referenceIntersection(const uint32_t *a, int a_size, const uint32_t *b, int b_size, uint32_t *ids)
+{
+    int size = 0;
+
+    for(int i = 0, j = 0; i < a_size && j < b_size; ) // loop until at least one set is fully processed
+    {
+        if(a[i] < b[j])
+            i++;
+        else if(a[i] > b[j])
+            j++;
+        else // if elements are the same
+        {
+            ids[size++] = a[i++];
+            j++;
+        }
+    }
+
+    return size;
+}
+
+// writes a difference of sorted sets 'a' and 'b' (a \ b) to 'ids' (reference engine), returns its size
+static int referenceDifference(const uint32_t *a, int a_size, const uint32_t *b, int b_size, uint32_t *ids)
+{
+    int size = 0;
+
+    for(int i = 0, j = 0; i < a_size; ) // loop until all elements from set 'a' are processed
+    {
+        // if all elements from the set 'b' were processed or a[i] is not in the set 'b'
+        if(j == b_size || a[i] < b[j])
+            ids[size++] = a[i++];
+        else if(a[i] > b[j])
+            j++;
+        else // if elements are the same
+        {
+            i++;
+            j++;
+        }
+    }
+
+    return size;
+}
+
+// computes an operation 'op' over 'count' sets (reference engine), the result will be stored in the set 'new'
+// sets are merged by two from the left (a \ b \ c ... is (a \ b) \ c ...)
+static bool referenceSetsOperation(const Relation_t **sets, int count, Relation_t *new, Set_operation_t op, int universe_size)
+{
+    uint32_t *acc = referenceIds(sets[0]); // accumulated result
+    int size = sets[0]->size;
+
+    for(int i = 1; i < count && acc != NULL; i++)
+    {
+        uint32_t *b = referenceIds(sets[i]);
+        uint32_t *ids = (uint32_t *) trackedMalloc((size + sets[i]->size + 1) * sizeof(uint32_t), MEMORY_TEMPORARY);
+
+        if(b != NULL && ids != NULL)
+        {
+            if(op == SET_UNION)
+                size = referenceUnion(acc, size, b, sets[i]->size, ids);
+            else if(op == SET_INTERSECT)
+                size = referenceIntersection(acc, size, b, sets[i]->size, ids);
+            else
+                size = referenceDifference(acc, size, b, sets[i]->size, ids);
+        }
+        else
+        {
+            trackedFree(ids);
+            ids = NULL;
+        }
+
+        trackedFree(acc);
+        trackedFree(b);
+        acc = ids;
+    }
+
+    if(acc == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set\n");
+        return false;
+    }
+
+    bool result = setFromIds(new, acc, size, universe_size);
+
+    trackedFree(acc);
+    return result;
+}
+
+// computes a complement of the set 'a' as a difference U \ a (reference engine)
+// the complement will be stored in the set 'new'
+static bool referenceComplement(const Relation_t *a, Relation_t *new, const Relation_t *universal_set)
+{
+    const Relation_t *sets[] = {universal_set, a};
+
+    return referenceSetsOperation(sets, 2, new, SET_MINUS, universal_set->size);
+}
+
+// checks if set 'a' is a subset of set 'b' (reference engine)
+static bool referenceIsSubset(const Relation_t *a, const Relation_t *b)
+{
+    // if size of set 'a' is greater than a size of set 'b' it can't be a subset of set 'b'
+    if(a->size > b->size)
+        return false;
+
+    if(isEmpty(a)) // empty set is a subset of every set
+        return true;
+    else
+    {
+        if(isEmpty(b)) // non-empty set can't be a subset of empty set
+            return false;
+    }
+
+    Set_iterator_t it;
+    setIteratorCtor(&it, a);
+
+    while(setIteratorNext(&it))
+        if(!setContains(b, it.id)) // if element from set 'a' doesn't belong to the set 'b'
+            return false;
+
+    return true;
+}
+
+// checks if set 'a' and set 'b' are equal (reference engine)
+static bool referenceIsEqual(const Relation_t *a, const Relation_t *b)
+{
+    if(a->size != b->size) // equal sets must have the same sizes
+        return false;
+
+    // compare sorted set elements
+    Set_iterator_t it_a, it_b;
+    setIteratorCtor(&it_a, a);
+    setIteratorCtor(&it_b, b);
+
+    while(setIteratorNext(&it_a) && setIteratorNext(&it_b))
+        if(it_a.id != it_b.id)
+            return false;
+
+    return true;
+}
+
+// checks if set 'a' is a proper subset of set 'b' (reference engine)
+static bool referenceIsProperSubset(const Relation_t *a, const Relation_t *b)
+{
+    // set 'a' is a proper subset of set 'b' if it is a subset of set 'b' and sets 'a' and 'b' are not equal
+    return !referenceIsEqual(a, b) && referenceIsSubset(a, b);
+}
+
+// checks if a relation has a property (with the same parameters as isReflexive(), isTransitive(), ...)
+typedef bool (*Property_check_t)(const Relation_t *r, const Relation_t *universal_set);
+
+// computes a closure of a relation (with the same parameters as transitiveClosure(), ...)
+typedef bool (*Closure_t)(const Relation_t *r, Relation_t *new, const Relation_t *universal_set);
+
+// computes a union, an intersection or a difference of sets (with the same parameters as setsOperation())
+typedef bool (*Combine_t)(const Relation_t **sets, int count, Relation_t *new, Set_operation_t op, int universe_size);
+
+// computes a complement of a set (with the same parameters as complementSet())
+typedef bool (*Complement_t)(const Relation_t *a, Relation_t *new, const Relation_t *universal_set);
+
+// compares two sets (with the same parameters as isSubset(), isProperSubset() and isEqual())
+typedef bool (*Compare_t)(const Relation_t *a, const Relation_t *b);
+
+// structure represents an engine: implementations of operations over sets, checks of properties and closures
+typedef struct {
+    Property_check_t check[PROPERTIES]; // checks of properties
+    Closure_t closure[PROPERTIES]; // closures that make the property hold (NULL if the property has no closure)
+    Combine_t combine; // "union", "intersect" and "minus"
+    Complement_t complement; // "complement"
+    Compare_t compare[SET_COMPARISONS]; // "subseteq", "subset" and "equals"
+} Engine_t;
+
+// engines that can be chosen by --engine=NAME (indexed by Engine_kind_t)
+static const Engine_t engines[] = {
+        {
+                {referenceIsReflexive, referenceIsSymmetric, referenceIsAntisymmetric, referenceIsTransitive,
+                 referenceIsFunction},
+                {referenceReflexiveClosure, referenceSymmetricClosure, NULL, referenceTransitiveClosure, NULL},
+                referenceSetsOperation,
+                referenceComplement,
+                {referenceIsSubset, referenceIsProperSubset, referenceIsEqual}
+        },
+        {
+                {isReflexive, isSymmetric, isAntisymmetric, isTransitive, isFunction},
+                {reflexiveClosure, symmetricClosure, NULL, transitiveClosure, NULL},
+                setsOperation,
+                complementSet,
+                {isSubset, isProperSubset, isEqual}
+        }
+};
+
+// structure represents options and statistics of engines
+typedef struct {
+    Engine_kind_t kind; // engine chosen by --engine=NAME
+    bool isVerified; // both engines are run and their results are compared (--verify)
+    bool isDifferent; // engines gave different results
+    bool isReported; // time spent by every engine is printed at the end (--engine-report)
+    clock_t time[ENGINE_AUTO]; // time spent by every engine
+    int remembered; // number of checks of properties answered by remembered results (hasProperty())
+} Engine_options_t;
+
+// options and statistics of engines
+static Engine_options_t engine_options = {.kind = ENGINE_FAST};
+
+// returns the engine that is used for operands with 'size' set elements/relation pairs together
+static Engine_kind_t selectEngine(int size)
+{
+    if(engine_options.kind != ENGINE_AUTO)
+        return engine_options.kind;
+
+    return size <= AUTO_REFERENCE_PAIRS ? ENGINE_REFERENCE : ENGINE_FAST;
+}
+
+// checks if the relation 'r' has the property 'property' by the engine 'kind' and measures its time
+static bool engineCheck(Engine_kind_t kind, Property_t property, const Relation_t *r, const Relation_t *universal_set)
+{
+    clock_t start = clock();
+    bool holds = engines[kind].check[property](r, universal_set);
+
+    engine_options.time[kind] += clock() - start;
+    return holds;
+}
+
+// computes a closure of the relation 'r' by the engine 'kind' and measures its time
+static bool engineClosure(Engine_kind_t kind, Property_t property, const Relation_t *r, Relation_t *new,
+                   const Relation_t *universal_set)
+{
+    clock_t start = clock();
+    bool result = engines[kind].closure[property](r, new, universal_set);
+
+    engine_options.time[kind] += clock() - start;
+    return result;
+}
+
+// computes an operation 'op' over 'count' sets by the engine 'kind' and measures its time
+static bool engineCombine(Engine_kind_t kind, const Relation_t **sets, int count, Relation_t *new, Set_operation_t op,
+                   int universe_size)
+{
+    clock_t start = clock();
+    bool result = engines[kind].combine(sets, count, new, op, universe_size);
+
+    engine_options.time[kind] += clock() - start;
+    return result;
+}
+
+// computes a complement of the set 'a' by the engine 'kind' and measures its time
+static bool engineComplement(Engine_kind_t kind, const Relation_t *a, Relation_t *new, const Relation_t *universal_set)
+{
+    clock_t start = clock();
+    bool result = engines[kind].complement(a, new, universal_set);
+
+    engine_options.time[kind] += clock() - start;
+    return result;
+}
+
+// compares sets 'a' and 'b' by the engine 'kind' and measures its time
+static bool engineCompare(Engine_kind_t kind, Set_comparison_t comparison, const Relation_t *a, const Relation_t *b)
+{
+    clock_t start = clock();
+    bool holds = engines[kind].compare[comparison](a, b);
+
+    engine_options.time[kind] += clock() - start;
+    return holds;
+}
+
+// checks if the relation 'r' has the property 'property'
+// the property is checked only once, then the remembered result is used (e.g. by conditions of go_to_line repeated
+// over the same relation or by conditions over closures, that are known to have their property)
+// if engines are verified, both engines check the property every time and a difference between them or from the
+// remembered result is printed
+static bool hasProperty(Relation_t *r, Property_t property, const Relation_t *universal_set)
+{
+    bool isKnown = (r->known_properties & 1 << property) != 0;
+
+    if(isKnown && !engine_options.isVerified)
+    {
+        engine_options.remembered++;
+        return (r->properties & 1 << property) != 0;
+    }
+
+    Engine_kind_t kind = selectEngine(r->size);
+    bool holds = engineCheck(kind, property, r, universal_set);
+
+    if(engine_options.isVerified && engineCheck(!kind, property, r, universal_set) != holds)
+    {
+        reportError("Error! Engines differ: \"%s\" is %s by the %s engine and %s by the %s engine\n",
+                relation_commands[property], key_words[holds], engine_names[kind], key_words[!holds],
+                engine_names[!kind]);
+        engine_options.isDifferent = true;
+    }
+    else if(isKnown && ((r->properties & 1 << property) != 0) != holds)
+    {
+        reportError("Error! Engines differ: \"%s\" is %s by both engines, but %s was remembered\n",
+                relation_commands[property], key_words[holds], key_words[!holds]);
+        engine_options.isDifferent = true;
+    }
+
+    setProperty(r, property, holds);
+    return holds;
+}
+
+// compares sets 'a' and 'b' ("subseteq", "subset" or "equals" given by 'comparison')
+// if engines are verified, both engines compare sets and a difference is printed
+static bool compareSets(Set_comparison_t comparison, const Relation_t *a, const Relation_t *b)
+{
+    Engine_kind_t kind = selectEngine(a->size + b->size);
+    bool holds = engineCompare(kind, comparison, a, b);
+
+    if(engine_options.isVerified && engineCompare(!kind, comparison, a, b) != holds)
+    {
+        // comparisons are commands set_commands[6] ("subseteq") ... set_commands[8] ("equals")
+        reportError("Error! Engines differ: \"%s\" is %s by the %s engine and %s by the %s engine\n",
+                set_commands[6 + comparison], key_words[holds], engine_names[kind],
+                key_words[!holds], engine_names[!kind]);
+        engine_options.isDifferent = true;
+    }
+
+    return holds;
+}
+
+// prints a difference of sizes or the first element that is only in one of the sets 'a' and 'b' (made by engines
+// 'a_kind' and '!a_kind'), returns false if sets are equal
+static bool printSetDiff(const Relation_t *a, const Relation_t *b, Engine_kind_t a_kind, const Relation_t *universal_set)
+{
+    if(a->size != b->size) // e.g. one of the sets has an element twice
+    {
+        reportError("Error! Engines differ: the result of the %s engine has %d elements and the result of the %s "
+                "engine has %d elements\n", engine_names[a_kind], a->size, engine_names[!a_kind], b->size);
+        return true;
+    }
+
+    for(int k = 0; k < 2; k++)
+    {
+        const Relation_t *s = k == 0 ? a : b;
+        const Relation_t *other = k == 0 ? b : a;
+        Set_iterator_t it;
+
+        setIteratorCtor(&it, s);
+
+        while(setIteratorNext(&it))
+        {
+            if(!setContains(other, it.id))
+            {
+                reportError("Error! Engines differ: the element %s is only in the result of the %s engine\n",
+                        universal_set->names[it.id], engine_names[k == 0 ? a_kind : !a_kind]);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// prints a difference of sizes or the first relation pair that is only in one of the relations 'a' and 'b' (made by
+// engines 'a_kind' and '!a_kind'), returns false if relations are equal
+static bool printRelationDiff(const Relation_t *a, const Relation_t *b, Engine_kind_t a_kind, const Relation_t *universal_set)
+{
+    if(a->size != b->size) // e.g. one of the relations has a pair twice
+    {
+        reportError("Error! Engines differ: the result of the %s engine has %d pairs and the result of the %s "
+                "engine has %d pairs\n", engine_names[a_kind], a->size, engine_names[!a_kind], b->size);
+        return true;
+    }
+
+    for(int k = 0; k < 2; k++)
+    {
+        const Relation_t *r = k == 0 ? a : b;
+        const Relation_t *other = k == 0 ? b : a;
+
+        for(int i = 0; i < r->size; i++)
+        {
+            if(!hasPair(other, r->xs[i], r->ys[i]))
+            {
+                reportError("Error! Engines differ: the pair (%s %s) is only in the result of the %s engine\n",
+                        universal_set->names[r->xs[i]], universal_set->names[r->ys[i]],
+                        engine_names[k == 0 ? a_kind : !a_kind]);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// prints a closure of the relation 'r' that makes the property 'property' hold
+// the closure will be stored in the relation 'new'
+// if engines are verified, both engines compute the closure and a difference is printed
+static bool printClosure(const Relation_t *r, Relation_t *new, Property_t property, const Relation_t *universal_set)
+{
+    Engine_kind_t kind = selectEngine(r->size);
+
+    if(!engineClosure(kind, property, r, new, universal_set))
+        return false;
+
+    if(engine_options.isVerified)
+    {
+        Relation_t other;
+        relationCtor(&other, -1);
+
+        if(!engineClosure(!kind, property, r, &other, universal_set))
+        {
+            relationDtor(&other);
+            return false;
+        }
+
+        if(printRelationDiff(new, &other, kind, universal_set))
+            engine_options.isDifferent = true;
+
+        relationDtor(&other);
+    }
+
+    setProperty(new, property, true);
+    printRelation(new, universal_set);
+    return true;
+}
+
+// prints a result of the operation 'op' over sets with ids 'ids' ("union", "intersect" or "minus" with any number of
+// operands), the result will be stored in the set 'new'
+// if engines are verified, both engines compute the result and a difference is printed
+static bool printNaryOperation(Relation_arr_t *set_arr, const int *ids, int count, Relation_t *new, Set_operation_t op)
+{
+    const Relation_t **sets = (const Relation_t **) trackedMalloc(count * sizeof(Relation_t *), MEMORY_TEMPORARY);
+    int size = 0; // number of elements of all sets
+
+    if(sets == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for operands of the command\n");
+        return false;
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        sets[i] = findById(set_arr, ids[i]);
+
+        if(sets[i] == NULL)
+        {
+            reportError("Error! There doesn't exist a set/relation with specified id\n");
+            trackedFree(sets);
+            return false;
+        }
+
+        size += sets[i]->size;
+    }
+
+    Engine_kind_t kind = selectEngine(size);
+    bool result = engineCombine(kind, sets, count, new, op, set_arr->relation_arr->size);
+
+    if(result && engine_options.isVerified)
+    {
+        Relation_t other;
+        relationCtor(&other, -1);
+
+        result = engineCombine(!kind, sets, count, &other, op, set_arr->relation_arr->size);
+
+        if(result && printSetDiff(new, &other, kind, set_arr->relation_arr))
+            engine_options.isDifferent = true;
+
+        relationDtor(&other);
+    }
+
+    trackedFree(sets);
+
+    if(result)
+        printSet(new, set_arr->relation_arr);
+
+    return result;
+}
+
+// prints a complement of the set 'a' (U \ a)
+// the complement will be stored in the set 'new'
+// if engines are verified, both engines compute the complement and a difference is printed
+static bool printComplement(const Relation_t *a, Relation_t *new, const Relation_t *universal_set)
+{
+    Engine_kind_t kind = selectEngine(a->size);
+
+    if(!engineComplement(kind, a, new, universal_set))
+        return false;
+
+    if(engine_options.isVerified)
+    {
+        Relation_t other;
+        relationCtor(&other, -1);
+
+        if(!engineComplement(!kind, a, &other, universal_set))
+        {
+            relationDtor(&other);
+            return false;
+        }
+
+        if(printSetDiff(new, &other, kind, universal_set))
+            engine_options.isDifferent = true;
+
+        relationDtor(&other);
+    }
+
+    printSet(new, universal_set);
+    return true;
+}
+
+// prints time spent by every engine and the number of checks of properties answered by remembered results to the
+// stream 'f' (--engine-report)
+static void printEngineReport(FILE *f)
+{
+    if(!engine_options.isReported)
+        return;
+
+    for(int kind = 0; kind < ENGINE_AUTO; kind++)
+        fprintf(f, "Engine: %s: %.3f ms\n", engine_names[kind], 1000.0 * engine_options.time[kind] / CLOCKS_PER_SEC);
+
+    fprintf(f, "Engine: remembered properties: %d checks\n", engine_options.remembered);
+}
+
+// prints a composition of the relations 'r' and 's', i.e. pairs (x, z) where xRy and ySz for some y
+// the composition will be stored in the relation 'new'
+// it is a sparse boolean matrix product computed row by row over forward indexes of both relations
+static bool printComposition(const Relation_t *r, const Relation_t *s, Relation_t *new, const Relation_t *universal_set)
+{
+    int n = universal_set->size;
+    int capacity = n + 1;
+    int size = 0;
+
+    int *mark = (int *) trackedMalloc((n + 1) * sizeof(int), MEMORY_TEMPORARY); // mark[z] == x if (x, z) was already added to the row of x
+    int *row = (int *) trackedMalloc((n + 1) * sizeof(int), MEMORY_TEMPORARY); // elements z of the current row
+    int *xs = (int *) trackedMalloc(capacity * sizeof(int), MEMORY_TEMPORARY);
+    int *ys = (int *) trackedMalloc(capacity * sizeof(int), MEMORY_TEMPORARY);
+
+    if(mark == NULL || row == NULL || xs == NULL || ys == NULL)
+    {
+        trackedFree(mark);
+        trackedFree(row);
+        trackedFree(xs);
+        trackedFree(ys);
+        reportError("Error! Couldn't allocate memory for a composition of relations\n");
+        return false;
+    }
+
+    for(int z = 0; z < n; z++)
+        mark[z] = -1;
+
+    for(int x = 0; x < n; x++)
+    {
+        int row_size = 0;
+
+        // gather the row of x, every z only once
+        for(int i = r->fwd_start[x]; i < r->fwd_start[x + 1]; i++)
+        {
+            int y = r->fwd_adj[i];
+
+            for(int j = s->fwd_start[y]; j < s->fwd_start[y + 1]; j++)
+            {
+                if(mark[s->fwd_adj[j]] != x)
+                {
+                    mark[s->fwd_adj[j]] = x;
+                    row[row_size++] = s->fwd_adj[j];
+                }
+            }
+        }
+
+        if(row_size == 0)
+            continue;
+
+        if(row_size * 8 < n) // sparse row => sort gathered elements
+            qsort(row, row_size, sizeof(int), compareInt);
+        else // dense row => the marks are a bitmap of the row, scan them in order
+        {
+            row_size = 0;
+
+            for(int z = 0; z < n; z++)
+                if(mark[z] == x)
+                    row[row_size++] = z;
+        }
+
+        if(size + row_size > capacity) // make a space for the whole row
+        {
+            while(size + row_size > capacity)
+                capacity *= 2;
+
+            int *tmp_xs = (int *) trackedRealloc(xs, capacity * sizeof(int), MEMORY_TEMPORARY);
+
+            if(tmp_xs != NULL)
+                xs = tmp_xs;
+
+            int *tmp_ys = (int *) trackedRealloc(ys, capacity * sizeof(int), MEMORY_TEMPORARY);
+
+            if(tmp_ys != NULL)
+                ys = tmp_ys;
+
+            if(tmp_xs == NULL || tmp_ys == NULL)
+            {
+                trackedFree(mark);
+                trackedFree(row);
+                trackedFree(xs);
+                trackedFree(ys);
+                reportError("Error! Couldn't allocate memory for a composition of relations\n");
+                return false;
+            }
+        }
+
+        for(int i = 0; i < row_size; i++)
+        {
+            xs[size] = x;
+            ys[size++] = row[i];
+        }
+    }
+
+    bool result = relationFromIds(new, xs, ys, size, universal_set);
+
+    trackedFree(mark);
+    trackedFree(row);
+    trackedFree(xs);
+    trackedFree(ys);
+
+    if(result)
+        printRelation(new, universal_set);
+
+    return result;
+}
+
+// prints an inverse of the relation 'r', i.e. pairs (y, x) where xRy
+// the inverse will be stored in the relation 'new'
+static bool printInverse(const Relation_t *r, Relation_t *new, const Relation_t *universal_set)
+{
+    // the reverse index of 'r' is already its transpose, so just read it row by row
+    int *xs = (int *) trackedMalloc((r->size + 1) * sizeof(int), MEMORY_TEMPORARY);
+    int *ys = (int *) trackedMalloc((r->size + 1) * sizeof(int), MEMORY_TEMPORARY);
+
+    if(xs == NULL || ys == NULL)
+    {
+        trackedFree(xs);
+        trackedFree(ys);
+        reportError("Error! Couldn't allocate memory for an inverse relation\n");
+        return false;
+    }
+
+    for(int y = 0, size = 0; y < universal_set->size; y++)
+    {
+        for(int i = r->rev_start[y]; i < r->rev_start[y + 1]; i++)
+        {
+            xs[size] = y;
+            ys[size++] = r->rev_adj[i];
+        }
+    }
+
+    bool result = relationFromIds(new, xs, ys, r->size, universal_set);
+
+    trackedFree(xs);
+    trackedFree(ys);
+
+    if(result)
+        printRelation(new, universal_set);
+
+    return result;
+}
+
+// finds a representative of the class of the element 'x' and compresses the path to it
+static int findClass(int *parent, int x)
+{
+    int root = x;
+
+    while(parent[root] != root)
+        root = parent[root];
+
+    while(parent[x] != root) // point every element on the path directly to the representative
+    {
+        int next = parent[x];
+        parent[x] = root;
+        x = next;
+    }
+
+    return root;
+}
+
+// merges classes of the elements 'x' and 'y' (the smaller class is attached to the bigger one)
+static void unionClasses(int *parent, int *class_size, int x, int y)
+{
+    x = findClass(parent, x);
+    y = findClass(parent, y);
+
+    if(x == y)
+        return;
+
+    if(class_size[x] < class_size[y])
+    {
+        int tmp = x;
+        x = y;
+        y = tmp;
+    }
+
+    parent[y] = x;
+    class_size[x] += class_size[y];
+}
+
+// frees the memory allocated for a partition
+static void partitionDtor(Partition_t *p)
+{
+    trackedFree(p->class_of);
+    trackedFree(p->class_start);
+    trackedFree(p->members);
+    p->class_of = p->class_start = p->members = NULL;
+    p->size = 0;
+}
+
+// splits the universal set into equivalence classes of the equivalence closure of the relation 'r'
+// uses union-find over universe element ids, classes are ordered by their smallest element
+static bool partitionCtor(Partition_t *p, const Relation_t *r, const Relation_t *universal_set)
+{
+    int n = universal_set->size;
+
+    p->size = 0;
+    p->class_of = (int *) trackedMalloc((n + 1) * sizeof(int), MEMORY_TEMPORARY);
+    p->class_start = (int *) trackedCalloc(n + 2, sizeof(int), MEMORY_TEMPORARY);
+    p->members = (int *) trackedMalloc((n + 1) * sizeof(int), MEMORY_TEMPORARY);
+
+    int *parent = (int *) trackedMalloc((n + 1) * sizeof(int), MEMORY_TEMPORARY);
+    int *class_size = (int *) trackedMalloc((n + 1) * sizeof(int), MEMORY_TEMPORARY);
+
+    if(p->class_of == NULL || p->class_start == NULL || p->members == NULL || parent == NULL || class_size == NULL)
+    {
+        trackedFree(parent);
+        trackedFree(class_size);
+        partitionDtor(p);
+        reportError("Error! Couldn't allocate memory for equivalence classes\n");
+        return false;
+    }
+
+    for(int x = 0; x < n; x++)
+    {
+        parent[x] = x;
+        class_size[x] = 1;
+    }
+
+    for(int x = 0; x < n; x++)
+        for(int i = r->fwd_start[x]; i < r->fwd_start[x + 1]; i++)
+            unionClasses(parent, class_size, x, r->fwd_adj[i]);
+
+    // number classes in order of their smallest elements (class_size[] is reused for the class index of a root)
+    for(int x = 0; x < n; x++)
+        class_size[x] = -1;
+
+    for(int x = 0; x < n; x++)
+    {
+        int root = findClass(parent, x);
+
+        if(class_size[root] == -1)
+            class_size[root] = p->size++;
+
+        p->class_of[x] = class_size[root];
+        p->class_start[p->class_of[x] + 1]++;
+    }
+
+    for(int c = 0; c < p->size; c++)
+        p->class_start[c + 1] += p->class_start[c];
+
+    // fill members in order of ids, so every class is sorted (parent[] is reused for the next free position)
+    memcpy(parent, p->class_start, p->size * sizeof(int));
+
+    for(int x = 0; x < n; x++)
+        p->members[parent[p->class_of[x]]++] = x;
+
+    trackedFree(parent);
+    trackedFree(class_size);
+    return true;
+}
+
+// prints an equivalence closure of the relation 'r' (reflexive, symmetric and transitive closure)
+// the equivalence closure of the relation 'r' will be stored in the relation 'new'
+static bool printEquivalenceClosure(const Relation_t *r, Relation_t *new, const Relation_t *universal_set)
+{
+    Partition_t p;
+
+    if(!partitionCtor(&p, r, universal_set))
+        return false;
+
+    // every element is in the relation with every member of its class
+    int size = 0;
+
+    for(int c = 0; c < p.size; c++)
+        size += (p.class_start[c + 1] - p.class_start[c]) * (p.class_start[c + 1] - p.class_start[c]);
+
+    int *xs = (int *) trackedMalloc((size + 1) * sizeof(int), MEMORY_TEMPORARY);
+    int *ys = (int *) trackedMalloc((size + 1) * sizeof(int), MEMORY_TEMPORARY);
+
+    if(xs == NULL || ys == NULL)
+    {
+        trackedFree(xs);
+        trackedFree(ys);
+        partitionDtor(&p);
+        reportError("Error! Couldn't allocate memory for an equivalence closure\n");
+        return false;
+    }
+
+    for(int x = 0, i = 0; x < universal_set->size; x++)
+    {
+        int c = p.class_of[x];
+
+        for(int j = p.class_start[c]; j < p.class_start[c + 1]; j++)
+        {
+            xs[i] = x;
+            ys[i++] = p.members[j];
+        }
+    }
+
+    bool result = relationFromIds(new, xs, ys, size, universal_set);
+
+    trackedFree(xs);
+    trackedFree(ys);
+    partitionDtor(&p);
+
+    if(result)
+    {
+        setProperty(new, PROPERTY_REFLEXIVE, true);
+        setProperty(new, PROPERTY_SYMMETRIC, true);
+        setProperty(new, PROPERTY_TRANSITIVE, true);
+        printRelation(new, universal_set);
+    }
+
+    return result;
+}
+
+// prints equivalence classes of the equivalence closure of the relation 'r' like this: {a b} {c} ...
+static bool printClasses(const Relation_t *r, const Relation_t *universal_set)
+{
+    Partition_t p;
+
+    if(!partitionCtor(&p, r, universal_set))
+        return false;
+
+    for(int c = 0; c < p.size; c++)
+    {
+        if(c != 0)
+            printOutput(DELIMITER_STR);
+
+        printOutput("{");
+
+        for(int i = p.class_start[c]; i < p.class_start[c + 1]; i++)
+        {
+            if(i != p.class_start[c])
+                printOutput(DELIMITER_STR);
+
+            printOutput("%s", universal_set->names[p.members[i]]);
+        }
+
+        printOutput("}");
+    }
+
+    printOutput("\n");
+
+    partitionDtor(&p);
+    return true;
+}
+
+
+// prints elements reachable from the set 'a' by one step of the relation 'r' ("image")
+// or by one step of the inverse of the relation 'r' ("preimage", 'reverse' is true)
+// or by one or more steps of the relation 'r' ("reach", 'transitive' is true)
+// the result will be stored in the set 'new'
+// all elements of the set 'a' are sources of one traversal with a bitset frontier, so every reachable element
+// is expanded only once and elements that are not reachable are never visited
+static bool printTraversal(const Relation_t *r, const Relation_t *a, Relation_t *new, bool reverse, bool transitive,
+                    const Relation_t *universal_set)
+{
+    int words = bitsetWords(universal_set->size);
+
+    const int *start = reverse ? r->rev_start : r->fwd_start;
+    const int *adj = reverse ? r->rev_adj : r->fwd_adj;
+
+    uint64_t *reached = (uint64_t *) trackedCalloc(words + 1, sizeof(uint64_t), MEMORY_TEMPORARY); // elements reached at least by one step
+    int *frontier = (int *) trackedMalloc((universal_set->size + a->size + 1) * sizeof(int), MEMORY_TEMPORARY); // elements to expand
+    int frontier_size = 0;
+
+    if(reached == NULL || frontier == NULL)
+    {
+        trackedFree(reached);
+        trackedFree(frontier);
+        reportError("Error! Couldn't allocate memory for a traversal of the relation\n");
+        return false;
+    }
+
+    // the first frontier are all the sources
+    Set_iterator_t it;
+    setIteratorCtor(&it, a);
+
+    while(setIteratorNext(&it))
+        frontier[frontier_size++] = it.id;
+
+    // expand the frontier, newly reached elements are the next frontier (only if 'transitive')
+    for(int i = 0; i < frontier_size; i++)
+    {
+        int x = frontier[i];
+
+        for(int j = start[x]; j < start[x + 1]; j++)
+        {
+            if(!bitsetTest(reached, adj[j]))
+            {
+                bitsetSet(reached, adj[j]);
+
+                if(transitive)
+                    frontier[frontier_size++] = adj[j];
+            }
+        }
+    }
+
+    bool result = setFromBitset(new, reached, universal_set->size);
+
+    trackedFree(reached);
+    trackedFree(frontier);
+
+    if(result)
+        printSet(new, universal_set);
+
+    return result;
+}
+
+// checks if string contains a command that prints a set as its output
+static bool printsSet(char *str)
+{
+    for(int i = 2; i <= 5; i++)
+        if(strcmp(str, set_commands[i]) == 0)
+            return true;
+
+    // "image", "preimage" and "reach"
+    for(int i = 18; i <= 20; i++)
+        if(strcmp(str, relation_commands[i]) == 0)
+            return true;
+
+    return strcmp(str, relation_commands[5]) == 0 || strcmp(str, relation_commands[6]) == 0;
+}
+
+// checks if string contains a command that prints a relation as its output
+static bool printsRelation(char *operation)
+{
+    for(int i = 10; i <= 12; i++)
+        if(strcmp(operation, relation_commands[i]) == 0)
+            return true;
+
+    // "compose", "inverse" and "closure_eq"
+    return strcmp(operation, relation_commands[14]) == 0 || strcmp(operation, relation_commands[15]) == 0 ||
+           strcmp(operation, relation_commands[16]) == 0;
+}
+
+// seeds the pseudo-random number generator, its state is filled by the splitmix64 generator started from the seed
+static void randomSeed(uint64_t seed)
+{
+    for(int i = 0; i < 4; i++)
+    {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        random_state[i] = z ^ (z >> 31);
+    }
+}
+
+// returns the word rotated to the left by 'k' bits
+static uint64_t rotateLeft(uint64_t x, int k)
+{
+    return (x << k) | (x >> (WORD_BITS - k));
+}
+
+// returns the next pseudo-random number of the xoshiro256** generator
+static uint64_t randomNext(void)
+{
+    uint64_t *s = random_state;
+    uint64_t result = rotateLeft(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotateLeft(s[3], 45);
+
+    return result;
+}
+
+// returns a pseudo-random number from the interval [0, n)
+// the upper 32 bits of the random number are scaled to the interval by a multiplication instead of a modulo
+static int randomBelow(int n)
+{
+    return (int) (((randomNext() >> 32) * (uint64_t) n) >> 32);
+}
+
+// chooses 'k' distinct indexes from the interval [0, n) at random by Floyd's algorithm
+// it needs only 'k' random numbers, chosen indexes are written to 'chosen' in ascending order
+static void floydSample(int n, int k, int *chosen)
+{
+    for(int j = n - k, size = 0; j < n; j++, size++)
+    {
+        int t = randomBelow(j + 1);
+
+        // if 't' was already chosen 'j' is chosen instead ('j' is bigger than any index chosen before)
+        for(int i = 0; i < size; i++)
+        {
+            if(chosen[i] == t)
+            {
+                t = j;
+                break;
+            }
+        }
+
+        chosen[size] = t;
+    }
+
+    qsort(chosen, k, sizeof(int), compareInt);
+}
+
+// prints a random set element/relation pair from the set/relation with id 'id'
+static bool selectRandom(Relation_arr_t *relation_arr, Relation_arr_t *set_arr, int id, int *skip_lines)
+{
+    bool isRelation = true;
+    Relation_t *r = findById(relation_arr, id); // trying to find a relation by id
+
+    if(r == NULL) // if it couldn't find a relation by id trying to find a set by id
+    {
+        r = findById(set_arr, id);
+
+        if(r == NULL) // if it couldn't find either set/relation by id
+        {
+            reportError("Error! Couldn't find a set and relation with specified (%d) id\n", id);
+            return false;
+        }
+
+        isRelation = false; // if it could find a set by id
+    }
+
+    if(isEmpty(r)) // if set/relation is empty there is no need to print anything
+        return true;
+
+    int random_idx = randomBelow(r->size); // get a random index of set element/relation pair
+
+    if(isRelation) // print relation pair
+        printOutput("(%s %s)\n", set_arr->relation_arr->names[r->xs[random_idx]], set_arr->relation_arr->names[r->ys[random_idx]]);
+    else // print set element
+        printOutput("%s\n", set_arr->relation_arr->names[setElementAt(r, random_idx)]);
+
+    *skip_lines = 0; // there is no need to skip any number of lines because set/relation wasn't empty
+    return true;
+}
+
+// resizes a relation/set and initializes it at index 'a->size - 1' of the relation/set array
+static bool relationResizeAndCtor(Relation_arr_t *a, int line_cnt)
+{
+    if(relationArrayResize(a, a->size + 1) == NULL)
+    {
+        reportError("Error! Couldn't resize an array of set\n");
+        return false;
+    }
+
+    relationCtor(&a->relation_arr[a->size - 1], line_cnt + 1);
+    return true;
+}
+
+// prints 'k' distinct random elements of the set or 'k' distinct random pairs of the relation with id 'id'
+// (all of them if there are not enough), the sample will be stored as a new set/relation
+static bool sampleRandom(Relation_arr_t *relation_arr, Relation_arr_t *set_arr, int id, int k, int line_cnt)
+{
+    Relation_arr_t *a = findById(relation_arr, id) != NULL ? relation_arr : set_arr;
+
+    if(findById(a, id) == NULL) // if it couldn't find either set/relation by id
+    {
+        reportError("Error! Couldn't find a set and relation with specified (%d) id\n", id);
+        return false;
+    }
+
+    // the array is resized first because it can move the set/relation that is sampled
+    if(!relationResizeAndCtor(a, line_cnt))
+        return false;
+
+    const Relation_t *r = findById(a, id);
+    const Relation_t *universal_set = set_arr->relation_arr;
+    Relation_t *new = &a->relation_arr[a->size - 1];
+
+    if(k > r->size)
+        k = r->size;
+
+    int *chosen = (int *) trackedMalloc((k + 1) * sizeof(int), MEMORY_TEMPORARY);
+    int *xs = (int *) trackedMalloc((k + 1) * sizeof(int), MEMORY_TEMPORARY);
+    int *ys = (int *) trackedMalloc((k + 1) * sizeof(int), MEMORY_TEMPORARY);
+
+    if(chosen == NULL || xs == NULL || ys == NULL)
+    {
+        trackedFree(chosen);
+        trackedFree(xs);
+        trackedFree(ys);
+        reportError("Error! Couldn't allocate memory for a sample\n");
+        return false;
+    }
+
+    floydSample(r->size, k, chosen);
+
+    bool result;
+
+    if(a == set_arr)
+    {
+        // elements with chosen indexes are picked in one pass over the set
+        uint32_t *ids = (uint32_t *) xs;
+        Set_iterator_t it;
+        setIteratorCtor(&it, r);
+
+        for(int i = 0, j = 0; j < k && setIteratorNext(&it); i++)
+            if(i == chosen[j])
+                ids[j++] = it.id;
+
+        result = setFromIds(new, ids, k, universal_set->size);
+
+        if(result)
+            printSet(new, universal_set);
+    }
+    else
+    {
+        for(int i = 0; i < k; i++)
+        {
+            xs[i] = r->xs[chosen[i]];
+            ys[i] = r->ys[chosen[i]];
+        }
+
+        result = relationFromIds(new, xs, ys, k, universal_set);
+
+        if(result)
+            printRelation(new, universal_set);
+    }
+
+    trackedFree(chosen);
+    trackedFree(xs);
+    trackedFree(ys);
+    return result;
+}
+
+// returns an index of the command in set_commands (-1 if it isn't a command over sets)
+static int setCommandIndex(const char *str)
+{
+    for(int i = 0; i < ARRAY_SIZE(set_commands); i++)
+        if(strcmp(str, set_commands[i]) == 0)
+            return i;
+
+    return -1;
+}
+
+// checks if a command over sets (given by index in set_commands) can have 'children' operands
+static bool validExpressionArity(int op, int children)
+{
+    if(op == EXPRESSION_SAMPLE) // a set and a number of chosen elements
+        return children == 2;
+
+    if(op <= 2) // "empty", "card" and "complement"
+        return children == 1;
+
+    if(op <= 5) // "union", "intersect" and "minus"
+        return children >= 2;
+
+    return children == 2; // "subseteq", "subset" and "equals"
+}
+
+// adds a new node to the expression, returns its index (-1 if there are too many nodes)
+static int expressionNode(Expression_t *e, int op)
+{
+    if(e->size == MAX_EXPRESSION_NODES)
+        return -1;
+
+    Expression_node_t *n = &e->nodes[e->size];
+    n->op = op;
+    n->id = 0;
+    n->child = -1;
+    n->next = -1;
+    n->bits = NULL;
+    n->min_size = 0;
+    n->max_size = 0;
+    n->first_word = 0;
+    n->last_word = -1;
+
+    return e->size++;
+}
+
+// copies a word (a command name or a set id) from the expression to 'word', it ends with ' ', '(', ')' or '\0'
+// returns false if the word is empty or too long
+static bool expressionWord(char **pos, char *word)
+{
+    int length = strcspn(*pos, DELIMITER_STR "()");
+
+    if(length == 0 || length > MAX_OPERATOR_LENGTH)
+        return false;
+
+    memcpy(word, *pos, length);
+    word[length] = '\0';
+    *pos += length;
+
+    return true;
+}
+
+static int parseExpressionOperation(Expression_t *e, char **pos, bool isRoot);
+
+// parses one operand of a set expression: an id of the set or an operation in parentheses
+// returns an index of its node (-1 if it isn't valid)
+static int parseExpressionOperand(Expression_t *e, char **pos)
+{
+    if(**pos == '(')
+    {
+        (*pos)++;
+        int node = parseExpressionOperation(e, pos, false);
+
+        if(node == -1 || **pos != ')')
+            return -1;
+
+        (*pos)++;
+        return node;
+    }
+
+    char word[OPERATOR_BUFFER_SIZE];
+    int node = expressionNode(e, -1);
+
+    if(node == -1 || !expressionWord(pos, word) || !checkCommandParam(word, &e->nodes[node].id))
+        return -1;
+
+    return node;
+}
+
+// parses an operation of a set expression (its name followed by its operands)
+// nested operations must produce a set, the root operation is any command over sets
+// returns an index of its node (-1 if it isn't valid)
+static int parseExpressionOperation(Expression_t *e, char **pos, bool isRoot)
+{
+    char word[OPERATOR_BUFFER_SIZE];
+
+    if(!expressionWord(pos, word))
+        return -1;
+
+    int op = setCommandIndex(word);
+
+    if(op == -1 && isRoot && strcmp(word, relation_commands[21]) == 0) // "sample" of a set expression
+        op = EXPRESSION_SAMPLE;
+
+    if(op == -1 || (!isRoot && (op < 2 || op > 5)))
+        return -1;
+
+    int node = expressionNode(e, op);
+
+    if(node == -1)
+        return -1;
+
+    int children = 0;
+
+    for(int last = -1; **pos == DELIMITER_CHAR; children++)
+    {
+        (*pos)++;
+        int child = parseExpressionOperand(e, pos);
+
+        if(child == -1)
+            return -1;
+
+        // append a child to the end of the list of children
+        if(last == -1)
+            e->nodes[node].child = child;
+        else
+            e->nodes[last].next = child;
+
+        last = child;
+    }
+
+    // the last operand of a command that prints true or false can be go_to_line argument
+    if(isRoot && (op == 0 || (op >= 6 && op <= 8)) && !validExpressionArity(op, children) && validExpressionArity(op, children - 1))
+    {
+        int last = e->nodes[node].child;
+        int prev = -1;
+
+        for(; e->nodes[last].next != -1; last = e->nodes[last].next)
+            prev = last;
+
+        if(e->nodes[last].op != -1)
+            return -1;
+
+        e->go_to_line = e->nodes[last].id;
+        e->nodes[prev].next = -1;
+        e->size--; // the operand was parsed as the last node, so it can be removed
+        children--;
+    }
+
+    // the second operand of "sample" is a number of chosen elements, not a set
+    if(op == EXPRESSION_SAMPLE && children == 2)
+    {
+        int last = e->nodes[e->nodes[node].child].next;
+
+        if(e->nodes[last].op != -1)
+            return -1;
+
+        e->sample_size = e->nodes[last].id;
+        e->nodes[e->nodes[node].child].next = -1;
+        e->size--; // the operand was parsed as the last node, so it can be removed
+        children--;
+
+        return node;
+    }
+
+    return validExpressionArity(op, children) ? node : -1;
+}
+
+// merges operands of nested operations into the operation if it gives the same result
+// (union 2 (union 3 4)) => (union 2 3 4), (minus (minus 2 3) 4) => (minus 2 3 4)
+static void flattenExpression(Expression_t *e, int node)
+{
+    for(int child = e->nodes[node].child; child != -1; child = e->nodes[child].next)
+        flattenExpression(e, child);
+
+    int op = e->nodes[node].op;
+
+    if(op < 3 || op > 5)
+        return;
+
+    for(int prev = -1, child = e->nodes[node].child; child != -1; )
+    {
+        // a nested difference can be merged only if it is the first operand of a difference
+        if(e->nodes[child].op == op && (op != 5 || prev == -1))
+        {
+            // replace the child by the list of its children
+            int last = e->nodes[child].child;
+
+            while(e->nodes[last].next != -1)
+                last = e->nodes[last].next;
+
+            e->nodes[last].next = e->nodes[child].next;
+
+            if(prev == -1)
+                e->nodes[node].child = e->nodes[child].child;
+            else
+                e->nodes[prev].next = e->nodes[child].child;
+
+            child = e->nodes[child].child;
+            continue;
+        }
+
+        prev = child;
+        child = e->nodes[child].next;
+    }
+}
+
+// estimates sizes and non-empty words of the set produced by the node from sizes and smallest and largest elements of
+// the sets in the expression, returns false if some set doesn't exist
+static bool estimateExpression(Expression_t *e, int node, Relation_arr_t *set_arr)
+{
+    Expression_node_t *n = &e->nodes[node];
+    int universe_size = set_arr->relation_arr->size;
+
+    if(n->op == -1)
+    {
+        const Relation_t *s = findById(set_arr, n->id);
+
+        if(s == NULL)
+        {
+            reportError("Error! There doesn't exist a set/relation with specified id\n");
+            return false;
+        }
+
+        n->min_size = n->max_size = s->size;
+        n->first_word = s->size != 0 ? s->min_id / WORD_BITS : 0;
+        n->last_word = s->size != 0 ? s->max_id / WORD_BITS : -1;
+        return true;
+    }
+
+    for(int child = n->child; child != -1; child = e->nodes[child].next)
+        if(!estimateExpression(e, child, set_arr))
+            return false;
+
+    const Expression_node_t *first = &e->nodes[n->child];
+
+    // estimates of the first operand are the starting point of every operation
+    n->min_size = first->min_size;
+    n->max_size = first->max_size;
+    n->first_word = first->first_word;
+    n->last_word = first->last_word;
+
+    if(n->op == 2) // "complement"
+    {
+        n->min_size = universe_size - first->max_size;
+        n->max_size = universe_size - first->min_size;
+        n->first_word = 0;
+        n->last_word = bitsetWords(universe_size) - 1;
+    }
+    else if(n->op == 4) // "intersect" isn't bigger than any operand
+        n->min_size = 0;
+
+    for(int child = first->next; child != -1; child = e->nodes[child].next)
+    {
+        const Expression_node_t *c = &e->nodes[child];
+
+        if(n->op == 3) // "union" isn't smaller than any operand and it covers words of all operands
+        {
+            if(c->min_size > n->min_size)
+                n->min_size = c->min_size;
+
+            n->max_size = n->max_size + c->max_size < universe_size ? n->max_size + c->max_size : universe_size;
+
+            if(n->first_word > n->last_word || (c->first_word <= c->last_word && c->first_word < n->first_word))
+                n->first_word = c->first_word;
+
+            if(c->last_word > n->last_word)
+                n->last_word = c->last_word;
+        }
+        else if(n->op == 4) // "intersect" has only words shared by all operands
+        {
+            if(c->max_size < n->max_size)
+                n->max_size = c->max_size;
+
+            if(c->first_word > n->first_word)
+                n->first_word = c->first_word;
+
+            if(c->last_word < n->last_word)
+                n->last_word = c->last_word;
+        }
+        else // "minus" removes at most all elements of the operand
+            n->min_size = n->min_size > c->max_size ? n->min_size - c->max_size : 0;
+    }
+
+    if(n->first_word > n->last_word)
+        n->max_size = 0;
+
+    if(n->max_size == 0) // the set is surely empty, so all its words are empty
+    {
+        n->first_word = 0;
+        n->last_word = -1;
+    }
+
+    return true;
+}
+
+// tries to answer the root command of the expression that prints true or false (or a number in case of "card")
+// only from the estimates, returns -1 if the estimates are not enough
+static int estimateResult(const Expression_t *e)
+{
+    const Expression_node_t *root = &e->nodes[0];
+    const Expression_node_t *a = &e->nodes[root->child];
+    const Expression_node_t *b = a->next != -1 ? &e->nodes[a->next] : NULL; // the second operand
+
+    if(root->op == 1 && a->min_size == a->max_size) // "card"
+        return a->min_size;
+
+    if(root->op == 0 && (a->max_size == 0 || a->min_size > 0)) // "empty"
+        return a->max_size == 0;
+
+    if(root->op == 6 && a->max_size == 0) // an empty set is a subset of every set
+        return true;
+
+    if(root->op == 6 && a->min_size > b->max_size) // "subseteq", set 'a' is bigger than set 'b'
+        return false;
+
+    if(root->op == 7 && a->min_size >= b->max_size) // "subset", set 'a' isn't smaller than set 'b'
+        return false;
+
+    if(root->op == 8 && (a->min_size > b->max_size || b->min_size > a->max_size)) // "equals", sets can't have same sizes
+        return false;
+
+    if(root->op == 8 && a->max_size == 0 && b->max_size == 0) // both sets are empty
+        return true;
+
+    return -1;
+}
+
+// assigns a bitmap to every set in the expression
+// sets that are already kept in a bitmap are used directly, other ones are converted only once
+static bool prepareExpression(Expression_t *e, Relation_arr_t *set_arr)
+{
+    int universe_size = set_arr->relation_arr->size;
+
+    e->words = bitsetWords(universe_size);
+    e->last_mask = bitsetLastMask(universe_size);
+    e->leaf_bits = (uint64_t *) trackedMalloc((e->size * e->words + 1) * sizeof(uint64_t), MEMORY_TEMPORARY);
+
+    if(e->leaf_bits == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set expression\n");
+        return false;
+    }
+
+    for(int i = 0; i < e->size; i++)
+    {
+        if(e->nodes[i].op != -1)
+            continue;
+
+        // existence of every set was already checked by estimateExpression()
+        Relation_t *s = findById(set_arr, e->nodes[i].id);
+
+        if(s->kind == CONTAINER_BITMAP)
+            e->nodes[i].bits = s->bits;
+        else
+        {
+            setToBitset(s, &e->leaf_bits[i * e->words], e->words);
+            e->nodes[i].bits = &e->leaf_bits[i * e->words];
+        }
+    }
+
+    return true;
+}
+
+// evaluates word 'w' of the set produced by the node of the expression
+// the whole expression is evaluated word by word, so no intermediate set is ever built
+static uint64_t expressionValue(const Expression_t *e, int node, int w)
+{
+    const Expression_node_t *n = &e->nodes[node];
+
+    if(w < n->first_word || w > n->last_word) // the word is surely empty, so the subtree isn't evaluated at all
+        return 0;
+
+    if(n->op == -1)
+        return n->bits[w];
+
+    uint64_t word = expressionValue(e, n->child, w);
+
+    if(n->op == 2) // "complement"
+        return ~word & (w == e->words - 1 ? e->last_mask : ~(uint64_t) 0);
+
+    for(int child = e->nodes[n->child].next; child != -1; child = e->nodes[child].next)
+    {
+        if(word == 0 && n->op != 3) // an intersection/difference can't get any element back
+            break;
+
+        if(n->op == 3)
+            word |= expressionValue(e, child, w);
+        else if(n->op == 4)
+            word &= expressionValue(e, child, w);
+        else
+            word &= ~expressionValue(e, child, w);
+    }
+
+    return word;
+}
+
+// evaluates the root command of the expression that prints true or false (or a number in case of "card")
+// only words that can be non-empty are evaluated and the evaluation stops as soon as the result is known
+static int evaluateExpression(const Expression_t *e)
+{
+    const Expression_node_t *root = &e->nodes[0];
+    int a = root->child;
+    int b = e->nodes[a].next;
+
+    // words outside of the set 'a' can't change the result of "empty", "card" and "subseteq"
+    int first = e->nodes[a].first_word;
+    int last = e->nodes[a].last_word;
+
+    if(root->op == 7 || root->op == 8) // "subset" and "equals" also look at words of the set 'b'
+    {
+        if(first > last || (e->nodes[b].first_word <= e->nodes[b].last_word && e->nodes[b].first_word < first))
+            first = e->nodes[b].first_word;
+
+        if(e->nodes[b].last_word > last)
+            last = e->nodes[b].last_word;
+    }
+
+    int count = 0;
+    bool isEqualSets = true;
+
+    for(int w = first; w <= last; w++)
+    {
+        uint64_t word = expressionValue(e, a, w);
+
+        if(root->op == 1) // "card"
+            count += popcount(word);
+        else if(root->op == 0 && word != 0) // "empty"
+            return false;
+        else if(root->op >= 6)
+        {
+            uint64_t word_b = expressionValue(e, b, w);
+
+            if(root->op != 8 && (word & ~word_b) != 0) // not a subset
+                return false;
+
+            if(word != word_b)
+            {
+                if(root->op == 8) // not equal
+                    return false;
+
+                isEqualSets = false;
+            }
+        }
+    }
+
+    if(root->op == 1)
+        return count;
+
+    // "subset" is true only if sets are not equal, other commands are true if they didn't stop
+    return root->op != 7 || !isEqualSets;
+}
+
+// chooses 'k' distinct random elements of the set produced by the operand of "sample" by reservoir sampling
+// elements are produced word by word and only the chosen ones are kept, so the whole set is never built
+// the sample will be stored in the set 'new'
+static bool sampleExpression(const Expression_t *e, int k, Relation_t *new, const Relation_t *universal_set)
+{
+    uint32_t *ids = (uint32_t *) trackedMalloc((k + 1) * sizeof(uint32_t), MEMORY_TEMPORARY);
+
+    if(ids == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a sample\n");
+        return false;
+    }
+
+    const Expression_node_t *a = &e->nodes[e->nodes[0].child];
+    int seen = 0; // number of elements produced so far
+
+    for(int w = a->first_word; w <= a->last_word; w++)
+    {
+        for(uint64_t word = expressionValue(e, e->nodes[0].child, w); word != 0; word &= word - 1, seen++)
+        {
+            // the element replaces a random chosen one with probability k / (seen + 1)
+            int j = seen < k ? seen : randomBelow(seen + 1);
+
+            if(j < k)
+                ids[j] = w * WORD_BITS + lowestBit(word);
+        }
+    }
+
+    int size = seen < k ? seen : k;
+    qsort(ids, size, sizeof(uint32_t), compareId);
+
+    bool result = setFromIds(new, ids, size, universal_set->size);
+
+    trackedFree(ids);
+
+    if(result)
+        printSet(new, universal_set);
+
+    return result;
+}
+
+// processes a line with the command over sets whose operands are nested set expressions
+// e.g. "C card (intersect 2 (union 3 4))"
+static bool processExpression(char *line, Relation_arr_t *set_arr, int line_cnt, int *skip_lines)
+{
+    Expression_t *e = (Expression_t *) trackedMalloc(sizeof(Expression_t), MEMORY_TEMPORARY);
+
+    if(e == NULL)
+    {
+        reportError("Error! Couldn't allocate memory for a set expression\n");
+        return false;
+    }
+
+    e->size = 0;
+    e->go_to_line = 0;
+    e->sample_size = 0;
+    e->leaf_bits = NULL;
+
+    char *pos = line + 2;
+
+    if(parseExpressionOperation(e, &pos, true) != 0 || *pos != '\0')
+    {
+        reportError("Error! Invalid format of the line nc. %d with set/relation operation\n", line_cnt + 1);
+        trackedFree(e);
+        return false;
+    }
+
+    if(e->go_to_line != 0)
+    {
+        // you cant go to line that was already processed because it will cause an infinite loop
+        if(line_cnt + 1 >= e->go_to_line)
+        {
+            reportError("Error! Can't continue reading a file from the line nc. %d, because current line has nc. %d\n", e->go_to_line, line_cnt + 1);
+            trackedFree(e);
+            return false;
+        }
+
+        *skip_lines = e->go_to_line - line_cnt - 2;
+    }
+
+    int op = e->nodes[0].op;
+    bool result = true;
+
+    // if the output of the command is set => resize an array of sets in order to save the result of the command
+    if((op >= 2 && op <= 5) || op == EXPRESSION_SAMPLE)
+        result = relationResizeAndCtor(set_arr, line_cnt);
+
+    flattenExpression(e, 0);
+
+    // sizes of the sets are estimated first, so some commands are answered without evaluating the expression
+    result = result && estimateExpression(e, 0, set_arr);
+    int value = result ? estimateResult(e) : -1;
+
+    if(result && (value != -1 || prepareExpression(e, set_arr)))
+    {
+        if(op == EXPRESSION_SAMPLE)
+            result = sampleExpression(e, e->sample_size, &set_arr->relation_arr[set_arr->size - 1], set_arr->relation_arr);
+        else if(op >= 2 && op <= 5) // the command produces a set
+        {
+            uint64_t *bits = (uint64_t *) trackedMalloc((e->words + 1) * sizeof(uint64_t), MEMORY_TEMPORARY);
+            Relation_t *new = &set_arr->relation_arr[set_arr->size - 1];
+
+            for(int w = 0; bits != NULL && w < e->words; w++)
+                bits[w] = expressionValue(e, 0, w);
+
+            result = bits != NULL && setFromBitset(new, bits, set_arr->relation_arr->size);
+
+            if(result)
+                printSet(new, set_arr->relation_arr);
+            else if(bits == NULL)
+                reportError("Error! Couldn't allocate memory for a set\n");
+
+            trackedFree(bits);
+        }
+        else if(op == 1) // "card"
+            printNumber(value != -1 ? value : evaluateExpression(e));
+        else
+        {
+            value = value != -1 ? value : evaluateExpression(e);
+            printBool(value);
+
+            if(value)
+                *skip_lines = 0; // the output of the function is 'true' => no need to skip any lines
+        }
+    }
+    else
+        result = false;
+
+    trackedFree(e->leaf_bits);
+    trackedFree(e);
+    return result;
+}
+
+// processes a line with the command and executes it
+static bool processCommand(char *line, Relation_arr_t *set_arr, Relation_arr_t *relation_arr, int line_cnt, int *skip_lines)
+{
+    Command_t c = {.operands = {0, }};
+
+    if(strchr(line, '(') != NULL) // operands are nested set expressions
+        return processExpression(line, set_arr, line_cnt, skip_lines);
+
+    if(!parseOperation(line, &c))
+    {
+        reportError("Error! Invalid format of the line nc. %d with set/relation operation\n", line_cnt + 1);
+        return false;
+    }
+
+    // if commands prints true or false as its output or if it is "select" and go_to_line argument is not 0
+    if((printsTrueOrFalse(c.name) || strcmp(c.name, relation_commands[13]) == 0) && c.operands[3] != 0)
+    {
+        // you cant go to line that was already processed because it will cause an infinite loop
+        if(line_cnt + 1 >= c.operands[3])
+        {
+            reportError("Error! Can't continue reading a file from the line nc. %d, because current line has nc. %d\n", c.operands[3], line_cnt + 1);
+            return false;
+        }
+
+        *skip_lines = c.operands[3] - line_cnt - 2;
+    }
+
+    // if the output of the command is set => resize an array of sets in order to save the result of the command
+    if(printsSet(c.name))
+    {
+        if(!relationResizeAndCtor(set_arr, line_cnt))
+            return false;
+    }
+    // if the output of the command is relation => resize an array of relations in order to save the result of the command
+    if(printsRelation(c.name))
+    {
+        if(!relationResizeAndCtor(relation_arr, line_cnt))
+            return false;
+    }
+
+    // pointers that will hold an addresses of the sets/relations that are command arguments
+    Relation_t *r1, *s2, *s3;
+
+    // if command is not "select" or "sample" (they work with both sets and relations)
+    if(strcmp(c.name, relation_commands[13]) != 0 && strcmp(c.name, relation_commands[21]) != 0)
+    {
+        if(isSetCommand(c.name))
+            r1 = findById(set_arr, c.operands[0]); // get a set
+        else
+            r1 = findById(relation_arr, c.operands[0]); // get a relation
+
+        // second mandatory argument is always a set (except "compose" where it is a relation)
+        if(strcmp(c.name, relation_commands[14]) == 0)
+            s2 = findById(relation_arr, c.operands[1]);
+        else
+            s2 = findById(set_arr, c.operands[1]);
+
+        s3 = findById(set_arr, c.operands[2]); // third mandatory argument is always a set
+
+        // if it couldn't find a set/relation by specified id
+        if(r1 == NULL || (c.operands[1] != 0 && s2 == NULL) || (c.operands[2] != 0 && s3 == NULL))
+        {
+            reportError("Error! There doesn't exist a set/relation with specified id\n");
+            return false;
+        }
+    }
+
+    // executes needed command
+
+    if(strcmp(c.name, set_commands[0]) == 0)
+    {
+        if(isEmpty(r1))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, set_commands[1]) == 0)
+    {
+        printSetSize(r1);
+        return true;
+    }
+    else if(strcmp(c.name, set_commands[2]) == 0)
+    {
+        return printComplement(r1, &set_arr->relation_arr[set_arr->size - 1], set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, set_commands[3]) == 0)
+    {
+        return printNaryOperation(set_arr, c.nary_operands, c.nary_size, &set_arr->relation_arr[set_arr->size - 1], SET_UNION);
+    }
+    else if(strcmp(c.name, set_commands[4]) == 0)
+    {
+        return printNaryOperation(set_arr, c.nary_operands, c.nary_size, &set_arr->relation_arr[set_arr->size - 1],
+                                  SET_INTERSECT);
+    }
+    else if(strcmp(c.name, set_commands[5]) == 0)
+    {
+        return printNaryOperation(set_arr, c.nary_operands, c.nary_size, &set_arr->relation_arr[set_arr->size - 1], SET_MINUS);
+    }
+    else if(strcmp(c.name, set_commands[6]) == 0)
+    {
+        if(compareSets(SET_SUBSETEQ, r1, s2))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, set_commands[7]) == 0)
+    {
+        if(compareSets(SET_SUBSET, r1, s2))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, set_commands[8]) == 0)
+    {
+        if(compareSets(SET_EQUALS, r1, s2))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, relation_commands[0]) == 0)
+    {
+        if(hasProperty(r1, PROPERTY_REFLEXIVE, set_arr->relation_arr))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, relation_commands[1]) == 0)
+    {
+        if(hasProperty(r1, PROPERTY_SYMMETRIC, set_arr->relation_arr))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, relation_commands[2]) == 0)
+    {
+        if(hasProperty(r1, PROPERTY_ANTISYMMETRIC, set_arr->relation_arr))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, relation_commands[3]) == 0)
+    {
+        if(hasProperty(r1, PROPERTY_TRANSITIVE, set_arr->relation_arr))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, relation_commands[4]) == 0)
+    {
+        if(hasProperty(r1, PROPERTY_FUNCTION, set_arr->relation_arr))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, relation_commands[5]) == 0)
+    {
+        return printDomain(r1, &set_arr->relation_arr[set_arr->size - 1], set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[6]) == 0)
+    {
+        return printCodomain(r1, &set_arr->relation_arr[set_arr->size - 1], true, set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[7]) == 0)
+    {
+        if(isInjective(r1, s2, s3, set_arr->relation_arr))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, relation_commands[8]) == 0)
+    {
+        if(isSurjective(r1, s2, s3, set_arr->relation_arr))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, relation_commands[9]) == 0)
+    {
+        if(isBijective(r1, s2, s3, set_arr->relation_arr))
+        {
+            printBool(true);
+            *skip_lines = 0; // the output of the function is 'ture' => no need to skip any lines
+        }
+        else
+            printBool(false);
+
+        return true;
+    }
+    else if(strcmp(c.name, relation_commands[10]) == 0)
+    {
+        return printClosure(r1, &relation_arr->relation_arr[relation_arr->size - 1], PROPERTY_REFLEXIVE, set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[11]) == 0)
+    {
+        return printClosure(r1, &relation_arr->relation_arr[relation_arr->size - 1], PROPERTY_SYMMETRIC, set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[12]) == 0)
+    {
+        return printClosure(r1, &relation_arr->relation_arr[relation_arr->size - 1], PROPERTY_TRANSITIVE, set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[13]) == 0)
+    {
+        return selectRandom(relation_arr, set_arr, c.operands[0], skip_lines);
+    }
+    else if(strcmp(c.name, relation_commands[21]) == 0)
+    {
+        return sampleRandom(relation_arr, set_arr, c.operands[0], c.operands[1], line_cnt);
+    }
+    else if(strcmp(c.name, relation_commands[14]) == 0)
+    {
+        return printComposition(r1, s2, &relation_arr->relation_arr[relation_arr->size - 1], set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[15]) == 0)
+    {
+        return printInverse(r1, &relation_arr->relation_arr[relation_arr->size - 1], set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[16]) == 0)
+    {
+        return printEquivalenceClosure(r1, &relation_arr->relation_arr[relation_arr->size - 1], set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[17]) == 0)
+    {
+        return printClasses(r1, set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[18]) == 0)
+    {
+        return printTraversal(r1, s2, &set_arr->relation_arr[set_arr->size - 1], false, false, set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[19]) == 0)
+    {
+        return printTraversal(r1, s2, &set_arr->relation_arr[set_arr->size - 1], true, false, set_arr->relation_arr);
+    }
+    else if(strcmp(c.name, relation_commands[20]) == 0)
+    {
+        return printTraversal(r1, s2, &set_arr->relation_arr[set_arr->size - 1], false, true, set_arr->relation_arr);
+    }
+
+    // else
+
+    reportError("Error! Incorrect format of line with set/relation operation\n");
+    return false;
+}
+
+// reads a name of the relation pair element that ends with the character 'end' from '*pos' to 'name'
+// '*pos' moves after the character 'end', returns false if there isn't a name of the right length
+static bool scanPairElement(char **pos, char end, char *name)
+{
+    int length = strcspn(*pos, DELIMITER_STR "()");
+
+    if(length == 0 || length > MAX_SET_ELEMENT_LENGTH || (*pos)[length] != end)
+        return false;
+
+    memcpy(name, *pos, length);
+    name[length] = '\0';
+    *pos += length + 1;
+
+    return true;
+}
+
+// reads relation pairs "(x y) (x y) ..." in one pass over the line and interns their elements, i.e. replaces names
+// by ids from the universal set, ids of the i-th pair are written to xs[i] and ys[i]
+// every pair must be preceded by exactly one delimiter (space), parentheses can't be nested
+// returns a number of pairs (-1 if the line isn't valid)
+static int parseRelationPairs(char *line, const Relation_t *universal, int *xs, int *ys, int line_cnt)
+{
+    char x[MAX_SET_ELEMENT_LENGTH + 1];
+    char y[MAX_SET_ELEMENT_LENGTH + 1];
+    int size = 0;
+
+    for(char *pos = line + 1; *pos != '\0'; size++)
+    {
+        if(pos[0] != DELIMITER_CHAR || pos[1] != '(')
+        {
+            reportError("Error! Invalid format of the line no. %d declaring a relation\n", line_cnt + 1);
+            return -1;
+        }
+
+        pos += 2;
+
+        if(!scanPairElement(&pos, DELIMITER_CHAR, x) || !scanPairElement(&pos, ')', y))
+        {
+            reportError("Error! Invalid format of the line no. %d declaring a relation\n", line_cnt + 1);
+            return -1;
+        }
+
+        if(!isValidSetElement(x) || !isValidSetElement(y))
+        {
+            reportError("Error! Invalid set element on line no. %d\n", line_cnt + 1);
+            return -1;
+        }
+
+        xs[size] = elementId(universal, x);
+        ys[size] = elementId(universal, y);
+
+        // check if both set elements from the relation pair belong to the universal set
+        if(xs[size] == -1 || ys[size] == -1)
+        {
+            reportError("Error! Each element of the relation pair must belong to the universal set\n");
+            return -1;
+        }
+    }
+
+    return size;
+}
+
+// sorts relation pairs (xs[i], ys[i]) by their first elements, pairs with the same first element keep their order
+// it is a counting sort over ids of 'n' universe elements
+static bool sortPairsByX(int *xs, int *ys, int size, int n)
+{
+    int *start = (int *) trackedCalloc(n + 1, sizeof(int), MEMORY_TEMPORARY);
+    int *tmp = (int *) trackedMalloc((2 * size + 1) * sizeof(int), MEMORY_TEMPORARY);
+
+    if(start == NULL || tmp == NULL)
+    {
+        trackedFree(start);
+        trackedFree(tmp);
+        reportError("Error! Couldn't allocate memory for sorting a relation\n");
+        return false;
+    }
+
+    for(int i = 0; i < size; i++)
+        start[xs[i] + 1]++;
+
+    for(int x = 0; x < n; x++)
+        start[x + 1] += start[x];
+
+    for(int i = 0; i < size; i++)
+    {
+        int j = start[xs[i]]++;
+        tmp[2 * j] = xs[i];
+        tmp[2 * j + 1] = ys[i];
+    }
+
+    for(int i = 0; i < size; i++)
+    {
+        xs[i] = tmp[2 * i];
+        ys[i] = tmp[2 * i + 1];
+    }
+
+    trackedFree(start);
+    trackedFree(tmp);
+    return true;
+}
+
+// checks if a relation contains a duplicate relation pair
+// rows of its forward index are sorted, so the same pairs are next to each other
+static bool containDuplicatePair(const Relation_t *r, int n)
+{
+    for(int x = 0; x < n; x++)
+        for(int i = r->fwd_start[x] + 1; i < r->fwd_start[x + 1]; i++)
+            if(r->fwd_adj[i] == r->fwd_adj[i - 1])
+                return true;
+
+    return false;
+}
+
+// parses relation pairs given by positions of their elements in the line "U" (a line "R# x1 y1 x2 y2 ...")
+// returns a number of relation pairs (-1 if they aren't valid)
+static int parseRelationPositions(char *line, const Relation_t *universal, int *xs, int *ys)
+{
+    char *pos = line + 2; // after "R#"
+    int size = 0;
+
+    for(char *token = nextToken(&pos); token != NULL; token = nextToken(&pos), size++)
+    {
+        int position = parsePosition(universal, token);
+
+        if(position == -1)
+        {
+            reportError("Error! Invalid position of a universe element '%s'\n", token);
+            return -1;
+        }
+
+        if(size % 2 == 0)
+            xs[size / 2] = positionId(universal, position);
+        else
+            ys[size / 2] = positionId(universal, position);
+    }
+
+    if(size % 2 != 0)
+    {
+        reportError("Error! Relation pair must have two elements\n");
+        return -1;
+    }
+
+    return size / 2;
+}
+
+// checks if relation pairs are sorted by x
+static bool isSortedByX(const int *xs, int size)
+{
+    for(int i = 1; i < size; i++)
+        if(xs[i - 1] > xs[i])
+            return false;
+
+    return true;
+}
+
+// parses a relation from the file
+static bool parseRelation(char *line, Relation_arr_t *relation_arr, int line_cnt, Relation_t *universal)
+{
+    if(relationArrayResize(relation_arr, relation_arr->size + 1) == NULL)
+    {
+        reportError("Error! Couldn't resize an array of relation_arr\n");
+        return false;
+    }
+
+    Relation_t *r = &relation_arr->relation_arr[relation_arr->size - 1];
+
+    relationCtor(r, line_cnt + 1);
+
+    // every relation pair " (x y)" takes at least 6 characters (" x y" of the line "R#" takes at least 4 characters)
+    int capacity = strlen(line) / (isPositionLine(line) ? 4 : 6) + 1;
+    int *xs = (int *) trackedMalloc(capacity * sizeof(int), MEMORY_TEMPORARY);
+    int *ys = (int *) trackedMalloc(capacity * sizeof(int), MEMORY_TEMPORARY);
+
+    if(xs == NULL || ys == NULL)
+    {
+        trackedFree(xs);
+        trackedFree(ys);
+        reportError("Error! Couldn't allocate memory for a relation\n");
+        return false;
+    }
+
+    int size;
+
+    if(isPositionLine(line))
+        size = parseRelationPositions(line, universal, xs, ys);
+    else
+        size = parseRelationPairs(line, universal, xs, ys, line_cnt);
+
+    // the relation is sorted by x (if it isn't sorted yet) and its indexes are built only once, right after it was parsed
+    bool result = size != -1 && (isSortedByX(xs, size) || sortPairsByX(xs, ys, size, universal->size)) &&
+                  relationFromIds(r, xs, ys, size, universal);
+
+    trackedFree(xs);
+    trackedFree(ys);
+
+    if(result && containDuplicatePair(r, universal->size))
+    {
+        reportError("Error! Each relation pair must be unique\n");
+        return false;
+    }
+
+    if(result)
+        printRelation(r, universal);
+
+    return result;
+}
+
+// initializes a reader of lines of the file 'f'
+static void lineReaderCtor(Line_reader_t *r, FILE *f)
+{
+    r->file = f;
+    r->pos = 0;
+    r->size = 0;
+    r->start = 0;
+}
+
+// moves the reader to the offset 'offset' of the file
+// the file isn't read again if the offset is in the block that was already read
+static bool lineReaderSeek(Line_reader_t *r, long offset)
+{
+    if(offset >= r->start && offset <= r->start + r->size)
+    {
+        r->pos = offset - r->start;
+        return true;
+    }
+
+    if(fseek(r->file, offset, SEEK_SET) != 0)
+        return false;
+
+    r->pos = 0;
+    r->size = 0;
+    r->start = offset;
+    return true;
+}
+
+// reads the next line of the file like fgets() does (at most 'size' - 1 characters including '\n')
+// lines are cut from the block that was read ahead, the file is read only when the whole block was used
+// returns a number of read characters (0 if there isn't any line more)
+static int readLine(Line_reader_t *r, char *line, int size)
+{
+    int length = 0;
+
+    while(length < size - 1)
+    {
+        if(r->pos == r->size) // read the next block of the file
+        {
+            r->start += r->size;
+            r->size = fread(r->buffer, 1, READ_BUFFER_SIZE, r->file);
+            r->pos = 0;
+
+            if(r->size == 0) // end of the file
+                break;
+        }
+
+        int n = r->size - r->pos < size - 1 - length ? r->size - r->pos : size - 1 - length;
+        char *end = (char *) memchr(&r->buffer[r->pos], '\n', n);
+
+        if(end != NULL) // the line ends in the block
+            n = end - &r->buffer[r->pos] + 1;
+
+        memcpy(&line[length], &r->buffer[r->pos], n);
+        length += n;
+        r->pos += n;
+
+        if(end != NULL)
+            break;
+    }
+
+    line[length] = '\0';
+    return length;
+}
+
+// reads the whole file in advance, finds the last line that uses every set/relation (by its id) and the start of
+// every line, every number in a command is taken as an id, so a set/relation is never freed too early
+// the reader is moved back to the beginning of the file
+static void prescanFile(Line_reader_t *reader, char *line, Liveness_t *l, Line_index_t *index)
+{
+    int line_cnt = 0; // number of read lines
+
+    for(int i = 0; i <= MAX_LINE_NUMBER; i++)
+    {
+        l->last_use[i] = 0;
+        l->first_dead[i] = -1;
+        l->next_dead[i] = -1;
+    }
+
+    // the file can't be read twice, nothing will be freed before the end of the file and skipped lines will be read
+    l->isKnown = index->isKnown = fseek(reader->file, 0, SEEK_CUR) == 0;
+    index->lines = 0;
+
+    if(!l->isKnown)
+        return;
+
+    index->offset[0] = 0;
+
+    while(readLine(reader, line, LINE_BUFFER_SIZE) != 0)
+    {
+        line_cnt++;
+
+        // lines after MAX_LINE_NUMBER are never processed (the file is invalid), they are only counted
+        if(line_cnt > MAX_LINE_NUMBER)
+            continue;
+
+        index->offset[line_cnt] = reader->start + reader->pos;
+        l->last_use[line_cnt] = line_cnt; // a set/relation is used by the line that defines it
+
+        if(line[0] != 'C')
+            continue;
+
+        for(char *pos = line; *pos != '\0'; pos++)
+        {
+            if(!isdigit(*pos) || (pos != line && isdigit(pos[-1])))
+                continue;
+
+            long id = strtol(pos, NULL, 10);
+
+            if(id >= 1 && id < line_cnt) // only sets/relations defined before the line can be used by it
+                l->last_use[id] = line_cnt;
+        }
+    }
+
+    index->lines = line_cnt;
+
+    // link ids with the same last use together
+    // the result of the last line is never freed, so it can be read after the end of the file (setcalResult())
+    for(int id = line_cnt < MAX_LINE_NUMBER ? line_cnt : MAX_LINE_NUMBER; id >= 1; id--)
+    {
+        if(id == line_cnt)
+            continue;
+
+        l->next_dead[id] = l->first_dead[l->last_use[id]];
+        l->first_dead[l->last_use[id]] = id;
+    }
+
+    rewind(reader->file);
+    lineReaderCtor(reader, reader->file);
+}
+
+// frees sets/relations whose last use is the line 'line_number' (the line was processed or skipped)
+// the universal set is used by every command, so it is never freed
+static void freeDeadResults(const Liveness_t *l, Relation_arr_t *set_arr, Relation_arr_t *relation_arr, int line_number)
+{
+    if(!l->isKnown)
+        return;
+
+    for(int id = l->first_dead[line_number]; id != -1; id = l->next_dead[id])
+    {
+        if(id == 1) // universal set
+            continue;
+
+        Relation_t *r = findById(set_arr, id);
+
+        if(r == NULL)
+            r = findById(relation_arr, id);
+
+        relationRelease(r);
+    }
+}
+
+// undoes a line of the set calculator 's' that failed: sets/relations made by the line are freed and the state is the
+// same as before the line ('sets' sets, 'relations' relations and the first character 'last_line' of the last line),
+// so the next line gets the same id as the failed one
+static void rollbackLine(Setcal_t *s, int sets, int relations, char last_line)
+{
+    for(int i = sets; i < s->set_arr.size; i++)
+        relationDtor(&s->set_arr.relation_arr[i]);
+
+    for(int i = relations; i < s->relation_arr.size; i++)
+        relationDtor(&s->relation_arr.relation_arr[i]);
+
+    s->set_arr.size = sets;
+    s->relation_arr.size = relations;
+    s->last_line = last_line;
+    s->skip_lines = 0;
+    s->result.kind = SETCAL_RESULT_NONE;
+}
+
+// processes one line of the input ('size' characters as they were read, including '\n') that isn't skipped
+// if the line fails, the set calculator is the same as before the line (rollbackLine())
+// sets/relations whose last use is the line are freed if their last uses 'liveness' are known (can be NULL)
+static bool processLine(Setcal_t *s, char *line, int size, const Liveness_t *liveness)
+{
+    Line_scan_t scan; // structure of the line
+
+    if(s->line_cnt == MAX_LINE_NUMBER)
+    {
+        reportError("Error! Too many lines in the file\n");
+        return false;
+    }
+
+    // state of the set calculator before the line
+    int sets = s->set_arr.size;
+    int relations = s->relation_arr.size;
+    char last_line = s->last_line;
+
+    if(!isValidLine(line, size, s->line_cnt, &s->last_line, &scan))
+    {
+        rollbackLine(s, sets, relations, last_line);
+        return false;
+    }
+
+    bool result;
+    memory_stats.line_peak = memory_stats.live;
+    memory_stats.isExceeded = false;
+    engine_options.isDifferent = false;
+
+    if(s->last_line == 'U' || s->last_line == 'S')
+        result = parseSet(line, scan.delimiters, &s->set_arr, s->line_cnt);
+    else if(s->last_line == 'R')
+        result = parseRelation(line, &s->relation_arr, s->line_cnt, s->set_arr.relation_arr);
+    else // if last_line == 'C'
+        result = processCommand(line, &s->set_arr, &s->relation_arr, s->line_cnt, &s->skip_lines);
+
+    if(result && engine_options.isDifferent)
+    {
+        reportError("Error! Engines gave different results on the line no. %d (--verify)\n", s->line_cnt + 1);
+        rollbackLine(s, sets, relations, last_line);
+        return false;
+    }
+
+    if(!result)
+    {
+        if(memory_stats.isExceeded) // the line failed because it needed too much memory
+            reportError("Error! Line no. %d needs more than %lu bytes of memory (--max-memory)\n", s->line_cnt + 1,
+                        (unsigned long) memory_stats.limit);
+
+        rollbackLine(s, sets, relations, last_line);
+        return false;
+    }
+
+    // a set/relation made by the line has the id of the line, other results were printed only ("select", "classes")
+    if(s->result.kind == SETCAL_RESULT_NONE)
+    {
+        s->result.id = s->line_cnt + 1;
+
+        if(findById(&s->set_arr, s->result.id) != NULL)
+            s->result.kind = SETCAL_RESULT_SET;
+        else if(findById(&s->relation_arr, s->result.id) != NULL)
+            s->result.kind = SETCAL_RESULT_RELATION;
+        else
+            s->result.kind = SETCAL_RESULT_TEXT;
+    }
+
+    if(liveness != NULL)
+        freeDeadResults(liveness, &s->set_arr, &s->relation_arr, s->line_cnt + 1);
+
+    if(memory_stats.report != NULL)
+    {
+        if(s->output != NULL) // the result of the line must be written before its report
+            fflush(s->output);
+
+        fprintf(memory_stats.report, "Memory: line %d: live %lu B, peak %lu B\n", s->line_cnt + 1,
+                (unsigned long) memory_stats.live, (unsigned long) memory_stats.line_peak);
+    }
+
+    s->line_cnt++;
+    return true;
+}
+
+// makes the set calculator 's' active and forgets the result and errors of its last line
+static void activate(Setcal_t *s)
+{
+    active = s;
+    s->error[0] = '\0';
+    s->result.kind = SETCAL_RESULT_NONE;
+    s->result.value = false;
+    s->result.number = 0;
+    s->result.id = 0;
+}
+
+Setcal_t *setcalCtor(void)
+{
+    Setcal_t *s = (Setcal_t *) trackedMalloc(sizeof(Setcal_t), MEMORY_ARRAY);
+
+    if(s == NULL)
+        return NULL;
+
+    // initialize array of sets and relations
+    relationArrayCtor(&s->set_arr);
+    relationArrayCtor(&s->relation_arr);
+
+    s->line_cnt = 0;
+    s->last_line = '\0';
+    s->skip_lines = 0;
+    s->output = NULL;
+    s->errors = NULL;
+    activate(s); // initialize the result and errors
+    active = NULL;
+
+    return s;
+}
+
+void setcalDtor(Setcal_t *s)
+{
+    if(s == NULL)
+        return;
+
+    relationArrayDtor(&s->set_arr);
+    relationArrayDtor(&s->relation_arr);
+
+    if(active == s)
+        active = NULL;
+
+    trackedFree(s);
+}
+
+void setcalOutput(Setcal_t *s, FILE *output)
+{
+    s->output = output;
+}
+
+void setcalErrors(Setcal_t *s, FILE *errors)
+{
+    s->errors = errors;
+}
+
+bool setcalLine(Setcal_t *s, const char *line)
+{
+    char buffer[LINE_BUFFER_SIZE]; // the line with '\n' like it is read from the file
+    int size = strlen(line);
+
+    activate(s);
+
+    if(s->skip_lines != 0) // if it is needed to skip the line
+    {
+        s->line_cnt++;
+        s->skip_lines--;
+        s->result.kind = SETCAL_RESULT_SKIPPED;
+        return true;
+    }
+
+    if(size > MAX_LINE_LENGTH)
+    {
+        reportError("Error! Invalid line no. %d length\n", s->line_cnt + 1);
+        return false;
+    }
+
+    memcpy(buffer, line, size);
+    buffer[size++] = '\n';
+    buffer[size] = '\0';
+
+    return processLine(s, buffer, size, NULL);
+}
+
+bool setcalFinish(Setcal_t *s)
+{
+    // the result of the last line is kept, only its errors are forgotten
+    active = s;
+    s->error[0] = '\0';
+
+    if(s->skip_lines != 0)
+    {
+        reportError("Error! Can't continue reading a file from the line no. %d because there are only %d lines in the file\n",
+                    s->line_cnt + s->skip_lines + 1, s->line_cnt);
+        return false;
+    }
+
+    if(s->last_line != 'C')
+    {
+        reportError("Error! Invalid file format: it must be like this: U -> R/S -> C\n");
+        return false;
+    }
+
+    return true;
+}
+
+bool setcalFile(Setcal_t *s, FILE *f)
+{
+    static Line_reader_t reader; // reader of lines of the file (static, because its buffer is big)
+    static Liveness_t liveness; // last uses of sets/relations (static, because it is big)
+    static Line_index_t index; // starts of lines of the file (static, because it is big)
+    char line[LINE_BUFFER_SIZE]; // line from the file
+    int size; // number of characters of the line
+
+    activate(s);
+    lineReaderCtor(&reader, f);
+    prescanFile(&reader, line, &liveness, &index);
+
+    // read the file until the end
+    while((size = readLine(&reader, line, LINE_BUFFER_SIZE)) != 0)
+    {
+        activate(s);
+
+        if(s->skip_lines != 0) // if it is needed to skip some lines
+        {
+            s->line_cnt++;
+            s->skip_lines--;
+            s->result.kind = SETCAL_RESULT_SKIPPED;
+
+            if(s->line_cnt <= MAX_LINE_NUMBER)
+                freeDeadResults(&liveness, &s->set_arr, &s->relation_arr, s->line_cnt);
+
+            continue;
+        }
+
+        if(!processLine(s, line, size, &liveness))
+            return false;
+
+        // skipped lines aren't read, the reader jumps to the start of the next processed line
+        if(s->skip_lines != 0 && index.isKnown && s->line_cnt + s->skip_lines <= MAX_LINE_NUMBER)
+        {
+            if(s->line_cnt + s->skip_lines > index.lines) // the jump is after the end of the file
+            {
+                s->skip_lines -= index.lines - s->line_cnt;
+                s->line_cnt = index.lines;
+                break;
+            }
+
+            for(; s->skip_lines != 0; s->skip_lines--)
+                freeDeadResults(&liveness, &s->set_arr, &s->relation_arr, ++s->line_cnt);
+
+            if(!lineReaderSeek(&reader, index.offset[s->line_cnt]))
+            {
+                reportError("Error! Couldn't move to the line no. %d of the file\n", s->line_cnt + 1);
+                return false;
+            }
+        }
+    }
+
+    return setcalFinish(s);
+}
+
+const char *setcalError(const Setcal_t *s)
+{
+    return s->error;
+}
+
+Setcal_result_t setcalResult(const Setcal_t *s)
+{
+    return s->result;
+}
+
+// finds a set (if 'isSet' is true) or a relation with the id 'id' in the set calculator 's'
+static Relation_t *setcalFind(const Setcal_t *s, int id, bool isSet)
+{
+    return findById((Relation_arr_t *) (isSet ? &s->set_arr : &s->relation_arr), id);
+}
+
+int setcalSetSize(const Setcal_t *s, int id)
+{
+    Relation_t *r = setcalFind(s, id, true);
+
+    return r != NULL ? r->size : -1;
+}
+
+const char *setcalSetElement(const Setcal_t *s, int id, int k)
+{
+    Relation_t *r = setcalFind(s, id, true);
+
+    if(r == NULL || k < 0 || k >= r->size)
+        return NULL;
+
+    return s->set_arr.relation_arr->names[setElementAt(r, k)];
+}
+
+int setcalSetElements(const Setcal_t *s, int id, const char **elements, int size)
+{
+    Relation_t *r = setcalFind(s, id, true);
+
+    if(r == NULL)
+        return -1;
+
+    // one pass of an iterator over the container (setcalSetElement() would walk it again for every element)
+    Set_iterator_t it;
+    int count = 0;
+    setIteratorCtor(&it, r);
+
+    while(count < size && setIteratorNext(&it))
+        elements[count++] = s->set_arr.relation_arr->names[it.id];
+
+    return count;
+}
+
+int setcalRelationSize(const Setcal_t *s, int id)
+{
+    Relation_t *r = setcalFind(s, id, false);
+
+    return r != NULL ? r->size : -1;
+}
+
+bool setcalRelationPair(const Setcal_t *s, int id, int k, const char **x, const char **y)
+{
+    Relation_t *r = setcalFind(s, id, false);
+
+    if(r == NULL || k < 0 || k >= r->size)
+        return false;
+
+    *x = s->set_arr.relation_arr->names[r->xs[k]];
+    *y = s->set_arr.relation_arr->names[r->ys[k]];
+    return true;
+}
+
+void setcalSeed(uint64_t seed)
+{
+    randomSeed(seed);
+}
+
+void setcalMaxMemory(size_t limit)
+{
+    memory_stats.limit = limit;
+}
+
+void setcalMemoryReport(FILE *report)
+{
+    memory_stats.report = report;
+}
+
+bool setcalEngine(const char *name)
+{
+    for(int kind = 0; kind < ENGINES; kind++)
+    {
+        if(strcmp(name, engine_names[kind]) == 0)
+        {
+            engine_options.kind = kind;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void setcalVerify(bool isVerified)
+{
+    engine_options.isVerified = isVerified;
+}
+
+void setcalEngineReport(bool isReported)
+{
+    engine_options.isReported = isReported;
+}
+
+void setcalReport(FILE *f)
+{
+    printMemoryReport(f);
+    printEngineReport(f);
+}
@@ -0,0 +1,120 @@
+// File: setcal.h
+// Subject: IZP
+// Project: #2
+// Author: Andrii Klymenko, FIT VUT
+// Login: xklyme00
+// Date: 28.7.2023
+
+// interface of the library libsetcal: the set calculator that can be used without running the program setcal
+// lines have the same format as lines of the input file of setcal (see README.md), ids of sets/relations are numbers
+// of lines that made them
+// all functions work with one set calculator at a time (the library isn't thread-safe)
+
+#ifndef SETCAL_H
+#define SETCAL_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// set calculator: the universe, sets, relations and the state of processed lines
+typedef struct Setcal Setcal_t;
+
+// kinds of results of a line
+typedef enum {
+    SETCAL_RESULT_NONE, // there isn't any result (no line was processed or the line failed)
+    SETCAL_RESULT_SKIPPED, // the line was skipped (go_to_line)
+    SETCAL_RESULT_BOOL, // "true" or "false"
+    SETCAL_RESULT_NUMBER, // a number ("card")
+    SETCAL_RESULT_SET, // a set (its elements are read by setcalSetSize() and setcalSetElement())
+    SETCAL_RESULT_RELATION, // a relation (its pairs are read by setcalRelationSize() and setcalRelationPair())
+    SETCAL_RESULT_TEXT // a result that is only printed ("select", "classes")
+} Setcal_result_kind_t;
+
+// structure represents a result of a line
+typedef struct {
+    Setcal_result_kind_t kind; // kind of the result
+    bool value; // value of SETCAL_RESULT_BOOL
+    int number; // value of SETCAL_RESULT_NUMBER
+    int id; // id of SETCAL_RESULT_SET and SETCAL_RESULT_RELATION
+} Setcal_result_t;
+
+// creates an empty set calculator (NULL if there is no memory)
+// results aren't printed and errors aren't printed until setcalOutput() and setcalErrors() are called
+Setcal_t *setcalCtor(void);
+
+// frees the set calculator 's' and all its sets/relations
+void setcalDtor(Setcal_t *s);
+
+// results of lines are printed to the stream 'output' like setcal prints them (NULL if they aren't printed)
+void setcalOutput(Setcal_t *s, FILE *output);
+
+// errors are printed to the stream 'errors' (NULL if they aren't printed), they can be read by setcalError() anyway
+void setcalErrors(Setcal_t *s, FILE *errors);
+
+// processes the next line 'line' (without '\n'), returns false if the line is invalid or its command failed
+// a failed line is undone (sets/relations made by it are freed), so the set calculator can be used further and the next
+// line gets the id of the failed one
+// a line skipped by go_to_line of a previous line isn't processed
+bool setcalLine(Setcal_t *s, const char *line);
+
+// checks if all lines were given (no line is missing for go_to_line and the last line is a command)
+// the result of the last line isn't changed, so it can still be read by setcalResult()
+bool setcalFinish(Setcal_t *s);
+
+// processes all lines of the file 'f' and calls setcalFinish()
+// sets/relations are freed after their last use in the file (if the file can be read twice), only the result of the
+// last line is always kept, so setcalResult() and setcalSetSize(), ... can read it after the file is processed
+// freed sets/relations don't exist anymore (setcalSetSize() returns -1 and commands over them fail)
+bool setcalFile(Setcal_t *s, FILE *f);
+
+// returns errors of the last line (empty string if there isn't any)
+const char *setcalError(const Setcal_t *s);
+
+// returns a result of the last line
+Setcal_result_t setcalResult(const Setcal_t *s);
+
+// returns a number of elements of the set with the id 'id' (-1 if there isn't such set)
+int setcalSetSize(const Setcal_t *s, int id);
+
+// returns the k-th element of the set with the id 'id' (elements are sorted), NULL if there isn't such element
+// it may walk the set from its start, so setcalSetElements() should be used to read the whole set
+const char *setcalSetElement(const Setcal_t *s, int id, int k);
+
+// writes at most 'size' elements of the set with the id 'id' to 'elements' (sorted) in one pass over the set
+// returns a number of written elements (-1 if there isn't such set)
+int setcalSetElements(const Setcal_t *s, int id, const char **elements, int size);
+
+// returns a number of pairs of the relation with the id 'id' (-1 if there isn't such relation)
+int setcalRelationSize(const Setcal_t *s, int id);
+
+// writes the k-th pair (x, y) of the relation with the id 'id' to '*x' and '*y', returns false if there isn't such pair
+bool setcalRelationPair(const Setcal_t *s, int id, int k, const char **x, const char **y);
+
+// options of the whole library (they are shared by all set calculators)
+
+// sets a seed of the pseudo-random number generator used by "select" and "sample"
+void setcalSeed(uint64_t seed);
+
+// limits memory allocated at the same time to 'limit' bytes (0 if there is no limit)
+void setcalMaxMemory(size_t limit);
+
+// memory used by every line is printed to the stream 'report' (NULL if it isn't printed)
+void setcalMemoryReport(FILE *report);
+
+// chooses an engine of set operations, relation properties and closures by its name ("reference", "fast" or "auto")
+// returns false if there isn't such engine
+bool setcalEngine(const char *name);
+
+// both engines are run and their results are compared (a difference is an error of the line)
+void setcalVerify(bool isVerified);
+
+// time spent by every engine is printed by setcalReport()
+void setcalEngineReport(bool isReported);
+
+// prints the peak memory (if setcalMemoryReport() was called) and time of engines (if setcalEngineReport() was called)
+// to 'f'
+void setcalReport(FILE *f);
+
+#endif // SETCAL_H
@@ -0,0 +1,189 @@
+// File: api.c
+// Subject: IZP
+// Project: #2
+// Author: Andrii Klymenko, FIT VUT
+// Login: xklyme00
+// Date: 28.7.2023
+
+// test of the library libsetcal: lines are given one by one and by a file, their results are read back and printed
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "setcal.h"
+
+// the library exports only functions declared in setcal.h, so a client can use names of its internals
+int active = 0;
+int popcount = 0;
+
+// names of kinds of results (indexed by Setcal_result_kind_t)
+const char *result_kinds[] = {"none", "skipped", "bool", "number", "set", "relation", "text"};
+
+// prints the result of the last line processed by the set calculator 's'
+void printResult(const Setcal_t *s)
+{
+    Setcal_result_t r = setcalResult(s);
+
+    printf("  %s", result_kinds[r.kind]);
+
+    if(r.kind == SETCAL_RESULT_BOOL)
+        printf(" %s", r.value ? "true" : "false");
+    else if(r.kind == SETCAL_RESULT_NUMBER)
+        printf(" %d", r.number);
+    else if(r.kind == SETCAL_RESULT_SET)
+    {
+        int size = setcalSetSize(s, r.id);
+        const char **elements = (const char **) malloc((size + 1) * sizeof(char *));
+
+        if(elements == NULL)
+        {
+            fprintf(stderr, "Error! Couldn't allocate memory for elements of a set\n");
+            exit(1);
+        }
+
+        size = setcalSetElements(s, r.id, elements, size);
+        printf(" %d:", r.id);
+
+        for(int k = 0; k < size; k++)
+        {
+            printf(" %s", elements[k]);
+
+            if(setcalSetElement(s, r.id, k) != elements[k]) // both functions must give the same elements
+                printf("(setcalSetElement: %s)", setcalSetElement(s, r.id, k));
+        }
+
+        free(elements);
+    }
+    else if(r.kind == SETCAL_RESULT_RELATION)
+    {
+        const char *x, *y;
+        printf(" %d:", r.id);
+
+        for(int k = 0; setcalRelationPair(s, r.id, k, &x, &y); k++)
+            printf(" (%s %s)", x, y);
+    }
+
+    printf("\n");
+}
+
+// gives lines 'lines' (ended by NULL) to a new set calculator one by one and prints their results and errors
+void testLines(const char **lines)
+{
+    Setcal_t *s = setcalCtor();
+
+    for(int i = 0; lines[i] != NULL; i++)
+    {
+        bool result = setcalLine(s, lines[i]);
+
+        printf("%s -> %s\n", lines[i], result ? "ok" : "failed");
+        printResult(s);
+
+        if(!result)
+            printf("  %s", setcalError(s));
+    }
+
+    bool result = setcalFinish(s);
+
+    printf("finish -> %s\n", result ? "ok" : "failed");
+    printResult(s);
+
+    if(!result)
+        printf("  %s", setcalError(s));
+
+    setcalDtor(s);
+}
+
+// gives the file with the content 'content' to a new set calculator and prints the result of its last line
+void testFile(const char *content)
+{
+    FILE *f = tmpfile();
+    Setcal_t *s = setcalCtor();
+
+    if(f == NULL || s == NULL)
+    {
+        fprintf(stderr, "Error! Couldn't create a file or a set calculator\n");
+        exit(1);
+    }
+
+    fputs(content, f);
+    rewind(f);
+
+    bool result = setcalFile(s, f);
+
+    printf("file -> %s\n", result ? "ok" : "failed");
+    printResult(s);
+
+    if(!result)
+        printf("  %s", setcalError(s));
+
+    setcalDtor(s);
+    fclose(f);
+}
+
+// gives the file with the content 'content' to a new set calculator, then looks up the set 'id' and gives it lines
+// 'lines' (ended by NULL), sets/relations freed after the file must be missing
+void testFreed(const char *content, int id, const char **lines)
+{
+    FILE *f = tmpfile();
+    Setcal_t *s = setcalCtor();
+    const char *element;
+
+    if(f == NULL || s == NULL)
+    {
+        fprintf(stderr, "Error! Couldn't create a file or a set calculator\n");
+        exit(1);
+    }
+
+    fputs(content, f);
+    rewind(f);
+
+    printf("file -> %s\n", setcalFile(s, f) ? "ok" : "failed");
+    printf("  set %d: size %d, elements %d\n", id, setcalSetSize(s, id), setcalSetElements(s, id, &element, 1));
+
+    for(int i = 0; lines[i] != NULL; i++)
+    {
+        bool result = setcalLine(s, lines[i]);
+
+        printf("%s -> %s\n", lines[i], result ? "ok" : "failed");
+        printResult(s);
+
+        if(!result)
+            printf("  %s", setcalError(s));
+    }
+
+    setcalDtor(s);
+    fclose(f);
+}
+
+int main()
+{
+    const char *lines[] = {"U a b c", "S a b", "R (a b) (b c)", "C card 2", "C transitive 3 7", "C closure_trans 3",
+                           "C complement 2", "C union 2 7", "C minus 2 20", NULL};
+    const char *unfinished[] = {"U a", "S a", NULL};
+    const char *skipped[] = {"U a b", "S a", "C empty 2 5", "C card 2", "C card 1", NULL};
+    const char *freed[] = {"C card 2", "C equals 2 3", "C card 4", NULL};
+    const char *failed[] = {"U a a", "U a b", "S a z", "S a", "R (a z)", "R (a b)", "S b", "C card 2", "C minus 2 9",
+                            "C minus 2 4", "C closure_ref 3", "C union 2 7", "C card 6", NULL};
+
+    testLines(lines);
+    testLines(unfinished);
+    testLines(skipped);
+    testLines(failed); // failed lines don't change ids of the next lines
+
+    // results of the last line of a file are kept after the file (other sets/relations are freed)
+    testFile("U a b c\nS a b\nS b c\nC union 2 3\n");
+    testFile("U a b c\nR (a b) (b c)\nC closure_trans 2\n");
+    testFile("U a b c\nS a b\nC card 2\n");
+    testFile("U a b c\nS a b\nC empty 2 5\nC card 2\nC complement 2\n");
+    testFile("U a b c\nS a b\n");
+
+    // sets freed after the file can't be found, the last line can
+    testFreed("U a b c\nS a b\nS b c\nC union 2 3\n", 2, freed);
+
+    // sets in runs and in bitmaps are read by one pass too
+    testFile("U a b c d e f g h i j k l m n o p q r s t u v w x y z\nS b c d e f g h i j k l m\nC complement 2\n");
+    testFile("U a b c d e f g h i j k l m n o p q r s t u v w x y z\nS a c e g i k m o q s u w y\nC complement 2\n");
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#!/bin/sh
+# runs tests of setcal from the root of the repository: sh tests/run.sh
+# tests/NAME.txt is an input file, tests/NAME.out is its expected output, tests/NAME.err are its expected errors (no
+# errors if it doesn't exist) and tests/NAME.args are options of the program (only the file if it doesn't exist)
+# tests/api.c drives the library libsetcal directly, tests/api.out is its expected output
+
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:--std=c99 -Wall -Wextra -Werror}
+DIR=$(mktemp -d)
+failed=0
+
+trap 'rm -rf "$DIR"' EXIT
+
+$CC $CFLAGS setcal.c libsetcal.c -o "$DIR/setcal" || exit 1
+$CC $CFLAGS -I. tests/api.c libsetcal.c -o "$DIR/api" || exit 1
+
+# compares the file $2 with the expected file $3 (an empty file if it doesn't exist) of the test $1
+check()
+{
+    expected=$3
+
+    if [ ! -f "$expected" ]; then
+        expected=/dev/null
+    fi
+
+    if ! diff -u "$expected" "$2" > "$DIR/diff"; then
+        echo "FAIL: $1"
+        cat "$DIR/diff"
+        failed=$((failed + 1))
+    fi
+}
+
+for input in tests/*.txt; do
+    [ -f "$input" ] || continue
+    name=${input%.txt}
+    args=
+
+    if [ -f "$name.args" ]; then
+        args=$(cat "$name.args")
+    fi
+
+    # times of engines differ from run to run
+    "$DIR/setcal" $args "$input" > "$DIR/out" 2> "$DIR/err"
+    sed 's/[0-9][0-9]*\.[0-9]* ms$/N ms/' "$DIR/err" > "$DIR/err_normalized"
+
+    check "$input" "$DIR/out" "$name.out"
+    check "$input (errors)" "$DIR/err_normalized" "$name.err"
+done
+
+(cd "$DIR" && ./api) > "$DIR/out" 2>&1
+check tests/api.c "$DIR/out" tests/api.out
+
+if [ $failed -ne 0 ]; then
+    echo "$failed test(s) failed"
+    exit 1
+fi
+
+echo "all tests passed"